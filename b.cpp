@@ -0,0 +1,4 @@
+#define FESDRER_STATS
+#define FESDRER_STATS_NO_NEW
+#include "/root/repo/fesdrerrand.h"
+void other(){auto t=RandomTree.random_tree(100);FESDRER_RAND::RandomStats.dump(stdout);}
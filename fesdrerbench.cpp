@@ -0,0 +1,404 @@
+/**
+ * fesdrerrand.h 的性能测试。
+ *
+ * 对每个生成函数在 10^3 到 10^7 的规模下计时，统计吞吐量（每秒生成的元素个数）、每次调用的内存申请次数和字节数、峰值内存，
+ * 结果以表格输出到 stderr，并以 JSON 写到文件，方便比较不同版本。
+ *
+ * 编译：g++ -O2 -std=c++11 -pthread fesdrerbench.cpp -o fesdrerbench
+ *
+ * 参数：
+ *   --max=N        最大规模，默认 1000000
+ *   --filter=S     只运行名字中包含 S 的测试
+ *   --min-time=T   每个测试至少运行 T 秒（最少运行一次），默认 0.2
+ *   --seed=S       随机种子，默认 1
+ *   --json=FILE    JSON 输出文件，默认 bench_output.txt
+ *
+ * @author Fesdrer
+ */
+#include "fesdrerrand.h"
+#include <new>
+#include <cstdio>
+#include <cstdlib>
+#include <fcntl.h>
+#ifdef _WIN32
+#include <windows.h>
+#include <psapi.h>
+#else
+#include <sys/resource.h>
+#endif
+
+
+//统计内存申请：所有的 new 都经过这里。定义了 FESDRER_STATS 时 fesdrerrand.h 已经替换了 operator new，直接读 RandomStats 的计数器。
+#if defined(FESDRER_STATS)&&!defined(FESDRER_STATS_NO_NEW)
+static inline long long bench_allocs(){return (long long)FESDRER_RAND::RandomStats.allocs.load();}
+static inline long long bench_bytes(){return (long long)FESDRER_RAND::RandomStats.bytes.load();}
+#else
+#if defined(__GNUC__)&&!defined(__clang__)&&__GNUC__>=11
+#pragma GCC diagnostic ignored "-Wmismatched-new-delete"
+#endif
+static std::atomic<long long> bench_allocs_count(0),bench_bytes_count(0);
+static inline long long bench_allocs(){return bench_allocs_count.load();}
+static inline long long bench_bytes(){return bench_bytes_count.load();}
+void* operator new(size_t n){
+	bench_allocs_count.fetch_add(1,std::memory_order_relaxed);
+	bench_bytes_count.fetch_add((long long)n,std::memory_order_relaxed);
+	void *p=malloc(n?n:1);
+	if(!p)	throw std::bad_alloc();
+	return p;
+}
+void* operator new[](size_t n){
+	return operator new(n);
+}
+void operator delete(void *p) noexcept{
+	free(p);
+}
+void operator delete[](void *p) noexcept{
+	free(p);
+}
+void operator delete(void *p,size_t) noexcept{
+	free(p);
+}
+void operator delete[](void *p,size_t) noexcept{
+	free(p);
+}
+#endif
+
+
+namespace FESDRER_BENCH{
+	//当前进程的峰值内存（KB）。Linux 上每个测试开始前会清零，所以是单个测试的峰值。
+	inline long long peak_rss(){
+#ifdef _WIN32
+		PROCESS_MEMORY_COUNTERS pmc;
+		if(GetProcessMemoryInfo(GetCurrentProcess(),&pmc,sizeof(pmc)))	return (long long)(pmc.PeakWorkingSetSize/1024);
+		return 0;
+#else
+		FILE *f=fopen("/proc/self/status","r");
+		if(f){
+			char line[256];
+			long long ret=-1;
+			while(fgets(line,sizeof(line),f))	if(!strncmp(line,"VmHWM:",6))	ret=atoll(line+6);
+			fclose(f);
+			if(ret>=0)	return ret;
+		}
+		struct rusage ru;
+		getrusage(RUSAGE_SELF,&ru);
+#ifdef __APPLE__
+		return (long long)ru.ru_maxrss/1024;
+#else
+		return (long long)ru.ru_maxrss;
+#endif
+#endif
+	}
+	//清零峰值内存，只在 Linux 上有效。
+	inline void reset_peak_rss(){
+#ifdef __linux__
+		FILE *f=fopen("/proc/self/clear_refs","w");
+		if(f)	fputs("5",f),fclose(f);
+#endif
+	}
+	inline double now(){
+		return std::chrono::duration<double>(std::chrono::steady_clock::now().time_since_epoch()).count();
+	}
+
+
+	struct Result{
+		std::string name;
+		int n;
+		long long items,reps,allocs,bytes,rss;
+		double seconds;
+	};
+
+
+	class BENCH{
+	private:
+		int max_n;
+		double min_time;
+		unsigned long long seed;
+		std::string filter;
+		std::vector<Result> results;
+	public:
+		BENCH():max_n(1000000),min_time(0.2),seed(1),filter(""),results(0){}
+		inline void config(int mx,double mt,unsigned long long sd,const std::string &f){
+			max_n=mx,min_time=mt,seed=sd,filter=f;
+		}
+		/*
+		在规模 10^3,10^4,...,min(limit,max_n) 下运行 f(n)，f 返回这次生成的元素个数。
+		每次运行前都用同一个种子重置随机数，所以相同版本的结果可以复现。
+		*/
+		template<typename F> inline void run(const std::string &name,int limit,F f){
+			if(!filter.empty()&&name.find(filter)==std::string::npos)	return;
+			for(int n=1000;n<=std::min(limit,max_n);n*=10){
+				Result r;
+				r.name=name,r.n=n,r.items=0,r.reps=0;
+				reset_peak_rss();
+#ifdef FESDRER_STATS
+				FESDRER_RAND::RandomStats.clear();
+#endif
+				long long a0=bench_allocs(),b0=bench_bytes();
+				double start=now(),used=0;
+				while(!r.reps||used<min_time){
+					FESDRER_RAND::random_seed(seed);
+					r.items+=f(n),r.reps++;
+					used=now()-start;
+				}
+				r.seconds=used/r.reps;
+				r.allocs=(bench_allocs()-a0)/r.reps,r.bytes=(bench_bytes()-b0)/r.reps;
+				r.rss=peak_rss();
+				r.items/=r.reps;
+				fprintf(stderr,"%-44s %9d %12.6f s %14.0f items/s %10lld allocs %14lld bytes %10lld KB\n",
+					name.c_str(),n,r.seconds,r.seconds>0?r.items/r.seconds:0.0,r.allocs,r.bytes,r.rss);
+				results.push_back(r);
+			}
+		}
+		inline void json(FILE *f){
+			fprintf(f,"{\n  \"engine\": \"%s\",\n  \"seed\": %llu,\n  \"benchmarks\": [\n",
+#if defined(FESDRER_ENGINE_PCG64)
+				"pcg64",
+#elif defined(FESDRER_ENGINE_PHILOX)
+				"philox4x32-10",
+#else
+				"xoshiro256**",
+#endif
+				seed);
+			for(size_t i=0;i<results.size();i++){
+				const Result &r=results[i];
+				fprintf(f,"    {\"name\": \"%s\", \"n\": %d, \"items\": %lld, \"reps\": %lld, \"seconds\": %.9f, \"items_per_second\": %.1f, \"allocs\": %lld, \"bytes\": %lld, \"peak_rss_kb\": %lld}%s\n",
+					r.name.c_str(),r.n,r.items,r.reps,r.seconds,r.seconds>0?r.items/r.seconds:0.0,r.allocs,r.bytes,r.rss,i+1<results.size()?",":"");
+			}
+			fprintf(f,"  ]\n}\n");
+		}
+	};
+	static BENCH Bench;
+
+
+	//所有测试。limit 为该测试允许的最大规模，复杂度较高的测试不会跑到 10^7。
+	inline void all(){
+		typedef std::vector<std::pair<int,int>> Graph;
+		BENCH &B=Bench;
+
+		B.run("FVector.push_back",10000000,[](int n){
+			FESDRER_STL::FVector v;
+			for(int i=0;i<n;i++)	v.push_back(i);
+			return (long long)n;
+		});
+		B.run("FVector.assign",10000000,[](int n){
+			FESDRER_STL::FVector v;
+			v.assign(n,1);
+			return (long long)n;
+		});
+		B.run("FVector.operator[]",10000000,[](int n){
+			FESDRER_STL::FVector v(n,1);
+			long long s=0;
+			for(int i=0;i<n;i++)	s+=v[int(FESDRER_RAND::random_bounded(n))];
+			return (long long)n+(s<0);
+		});
+		B.run("FVector.insert",1000000,[](int n){
+			FESDRER_STL::FVector v;
+			for(int i=0;i<n;i++)	v.insert(int(FESDRER_RAND::random_bounded(i+1)),i);
+			return (long long)n;
+		});
+		B.run("FVector.erase",1000000,[](int n){
+			FESDRER_STL::FVector v(n,1);
+			for(int i=n;i>0;i--)	v.erase(int(FESDRER_RAND::random_bounded(i)));
+			return (long long)n;
+		});
+		B.run("FVector.lower_bound",10000000,[](int n){
+			std::vector<int> a(n);
+			for(int i=0;i<n;i++)	a[i]=2*i;
+			FESDRER_STL::FVector v(a.begin(),a.end());
+			long long s=0;
+			for(int i=0;i<n;i++)	s+=v.lower_bound(int(FESDRER_RAND::random_bounded(2*n)));
+			return (long long)n+(s<0);
+		});
+
+		B.run("random",10000000,[](int n){
+			long long s=0;
+			for(int i=0;i<n;i++)	s+=random(1,1000000000);
+			return (long long)n+(s<0);
+		});
+		B.run("random.opt",10000000,[](int n){
+			long long s=0;
+			for(int i=0;i<n;i++)	s+=random(1,1000000000,2);
+			return (long long)n+(s<0);
+		});
+		B.run("FSampler.opt",10000000,[](int n){
+			FESDRER_RAND::FSampler R(1,1000000000,2);
+			long long s=0;
+			for(int i=0;i<n;i++)	s+=R();
+			return (long long)n+(s<0);
+		});
+		B.run("RandomBasic.random_sequence",10000000,[](int n){
+			return (long long)RandomBasic.random_sequence(n,1,1000000000).size();
+		});
+		B.run("RandomBasic.random_string",10000000,[](int n){
+			return (long long)RandomBasic.random_string(n).size();
+		});
+		B.run("RandomBasic.random_bracket_string",10000000,[](int n){
+			return (long long)RandomBasic.random_bracket_string(n/2*2,"()[]").size();
+		});
+		B.run("RandomBasic.fibonacci_string",10000000,[](int n){
+			return (long long)RandomBasic.fibonacci_string(n).size();
+		});
+		B.run("RandomDistinct.sample",10000000,[](int n){
+			return (long long)RandomDistinct.sample(10ll*n,n).size();
+		});
+
+		B.run("RandomAnother.random_different",10000000,[](int n){
+			return (long long)RandomAnother.random_different(1,10*n,n).size();
+		});
+		B.run("RandomAnother.random_divide",10000000,[](int n){
+			RandomAnother.random_divide(1,n,n/10);
+			return (long long)n;
+		});
+		B.run("RandomAnother.random_divide.limits",10000000,[](int n){
+			RandomAnother.random_divide(1,n,n/10,std::vector<int>(n/10,20));
+			return (long long)n;
+		});
+		B.run("RandomAnother.random_divide_num",10000000,[](int n){
+			return (long long)RandomAnother.random_divide_num(n,n/10).size();
+		});
+		B.run("RandomAnother.random_divide_uniform",10000000,[](int n){
+			return (long long)RandomAnother.random_divide_uniform(n,n/10).size();
+		});
+
+		B.run("RandomTree.random_tree",10000000,[](int n){return (long long)RandomTree.random_tree(n).size();});
+		B.run("RandomTree.random_tree.rho1",10000000,[](int n){return (long long)RandomTree.random_tree(n,1).size();});
+		B.run("RandomTree.random_flower_tree",10000000,[](int n){return (long long)RandomTree.random_flower_tree(n).size();});
+		B.run("RandomTree.random_chain_tree",10000000,[](int n){return (long long)RandomTree.random_chain_tree(n).size();});
+		B.run("RandomTree.random_lantern_tree",10000000,[](int n){return (long long)RandomTree.random_lantern_tree(n).size();});
+		B.run("RandomTree.random_binary_tree",10000000,[](int n){return (long long)RandomTree.random_binary_tree(n).size();});
+		B.run("RandomTree.random_uniform_binary_tree",10000000,[](int n){return (long long)RandomTree.random_uniform_binary_tree(n).size();});
+		B.run("RandomTree.random_tree_father",10000000,[](int n){return (long long)RandomTree.random_tree_father(n).size();});
+		B.run("RandomTree.random_prufer_tree",10000000,[](int n){return (long long)RandomTree.random_prufer_tree(n).size();});
+		B.run("RandomTree.random_max_degree_tree",10000000,[](int n){return (long long)RandomTree.random_max_degree_tree(n,3).size();});
+		B.run("RandomTree.random_height_tree",10000000,[](int n){return (long long)RandomTree.random_height_tree(n,n/10).size();});
+		B.run("RandomTree.random_diameter_tree",10000000,[](int n){return (long long)RandomTree.random_diameter_tree(n,n/10).size();});
+
+		for(int mask=0;mask<16;mask++){
+			bool c=mask&1,r=mask>>1&1,s=mask>>2&1,d=mask>>3&1;
+			char name[64];
+			sprintf(name,"RandomGraph.graph/c%dr%ds%dd%d",c,r,s,d);
+			B.run(name,10000000,[=](int n){
+				if(!RandomGraph.check(n,2*n,c,r,s,d))	return 0ll;
+				return (long long)RandomGraph.graph(n,2*n,c,r,s,d).size();
+			});
+		}
+		B.run("RandomGraph.graph.threads4",10000000,[](int n){return (long long)RandomGraph.graph(n,2*n,1,0,0,0,1,4).size();});
+		B.run("RandomGraph.graph_stream",10000000,[](int n){
+			long long s=0;
+			RandomGraph.graph_stream(n,2*n,1,0,0,0,1,[&](int x,int y){s+=x^y;});
+			return 2ll*n+(s<0);
+		});
+
+		for(int mask=0;mask<4;mask++){
+			bool s=mask&1,t=mask>>1&1;
+			char name[64];
+			sprintf(name,"RandomDag.dag/s%dt%d",s,t);
+			B.run(name,10000000,[=](int n){return (long long)RandomDag.dag(n,2*n,s,t).size();});
+		}
+		B.run("RandomScc.scc",10000000,[](int n){
+			std::vector<int> p=RandomScc.nm(n,3*n,1e9);
+			Graph dag=RandomDag.dag(p[2],p[3],0,0);
+			return (long long)RandomScc.scc(p[0],p[1],p[2],p[3],dag).size();
+		});
+		B.run("RandomEdcc.edcc",10000000,[](int n){
+			std::vector<int> p=RandomEdcc.nm(n,2*n,1e9);
+			Graph tree=RandomTree.random_tree(p[2]);
+			return (long long)RandomEdcc.edcc(p[0],p[1],p[2],tree).size();
+		});
+		B.run("RandomVdcc.vdcc",10000000,[](int n){
+			std::vector<int> p=RandomVdcc.nm(n,2*n,1e9);
+			return (long long)RandomVdcc.vdcc(p[0],p[1],p[2]).size();
+		});
+		B.run("RandomHackSpfa.hackspfa",10000000,[](int n){return (long long)RandomHackSpfa.hackspfa(n,1,1000000000).size();});
+		B.run("RandomHackSpfa.hackspfa.negative",10000000,[](int n){return (long long)RandomHackSpfa.hackspfa(n,-1000000000,1000000000).size();});
+		B.run("RandomHack.anti_hash",10000000,[](int n){return (long long)RandomHack.anti_hash(n,1000000000000000000LL).size();});
+		B.run("RandomHack.anti_dijkstra",10000000,[](int n){return (long long)RandomHack.anti_dijkstra(n,2*n,1000).size();});
+		B.run("RandomHack.anti_qsort",10000,[](int n){return (long long)RandomHack.anti_qsort(n).size();});
+		B.run("RandomHack.deep_tree",10000000,[](int n){return (long long)RandomHack.deep_tree(n,n/2).size();});
+		B.run("RandomFlow.dinic",10000000,[](int n){return (long long)RandomFlow.dinic(n,3*n,1,100).size();});
+		B.run("RandomFlow.push_relabel",10000000,[](int n){return (long long)RandomFlow.push_relabel(n,2*n,1,100).size();});
+		B.run("RandomFlow.matching",10000000,[](int n){return (long long)RandomFlow.matching(n,3*n).size();});
+
+		B.run("RandomPrint.print_sequence",10000000,[](int n){
+			std::vector<int> a(n,123456789);
+			RandomPrint.print_sequence(a);
+			return (long long)n;
+		});
+		B.run("RandomPrint.print_sequence_pair",10000000,[](int n){
+			std::vector<std::pair<int,int>> a(n,std::make_pair(123456,654321));
+			RandomPrint.print_sequence_pair(a);
+			return (long long)n;
+		});
+		B.run("RandomPrint.print_sequence_of_sequence",10000000,[](int n){
+			std::vector<std::vector<int>> a(n/10,std::vector<int>(10,123456));
+			RandomPrint.print_sequence_of_sequence(a);
+			return (long long)n;
+		});
+		B.run("RandomPrint.print_graph",10000000,[](int n){
+			Graph g(n,std::make_pair(123456,654321));
+			RandomPrint.print_graph(g);
+			return (long long)n;
+		});
+		B.run("RandomPrint.print_graph.weight",10000000,[](int n){
+			Graph g(n,std::make_pair(123456,654321));
+			RandomPrint.print_graph(g,1,1000000000);
+			return (long long)n;
+		});
+		B.run("RandomPrint.print_graph.weighted",10000000,[](int n){
+			std::vector<std::pair<std::pair<int,int>,int>> g(n,std::make_pair(std::make_pair(123456,654321),987654321));
+			RandomPrint.print_graph(g);
+			return (long long)n;
+		});
+		B.run("RandomPrint.print_tree_father",10000000,[](int n){
+			Graph t(n-1);
+			for(int i=2;i<=n;i++)	t[i-2]={i/2,i};
+			RandomPrint.print_tree_father(t);
+			return (long long)n;
+		});
+		B.run("RandomPrint.print_tree_father.array",10000000,[](int n){
+			std::vector<int> fa(n+1,0);
+			for(int i=2;i<=n;i++)	fa[i]=i/2;
+			RandomPrint.print_tree_father(fa);
+			return (long long)n;
+		});
+	}
+}
+
+
+int main(int argc,char **argv){
+	int max_n=1000000;
+	double min_time=0.2;
+	unsigned long long seed=1;
+	std::string filter="",json="bench_output.txt";
+	for(int i=1;i<argc;i++){
+		std::string a=argv[i];
+		if(!a.compare(0,6,"--max="))	max_n=atoi(a.c_str()+6);
+		else	if(!a.compare(0,9,"--filter="))	filter=a.substr(9);
+		else	if(!a.compare(0,11,"--min-time="))	min_time=atof(a.c_str()+11);
+		else	if(!a.compare(0,7,"--seed="))	seed=strtoull(a.c_str()+7,nullptr,10);
+		else	if(!a.compare(0,7,"--json="))	json=a.substr(7);
+		else{
+			fprintf(stderr,"usage: %s [--max=N] [--filter=S] [--min-time=T] [--seed=S] [--json=FILE]\n",argv[0]);
+			return 1;
+		}
+	}
+	//输出函数的结果直接丢掉，只计算格式化和写出的时间。
+#ifdef _WIN32
+	int null_fd=_open("NUL",_O_WRONLY);
+#else
+	int null_fd=open("/dev/null",O_WRONLY);
+#endif
+	if(null_fd>=0)	FESDRER_RAND::fout.redirect(null_fd);
+	FESDRER_BENCH::Bench.config(max_n,min_time,seed,filter);
+	FESDRER_BENCH::all();
+	FESDRER_RAND::fout.flush();
+	FILE *f=fopen(json.c_str(),"w");
+	if(!f){
+		fprintf(stderr,"cannot open %s\n",json.c_str());
+		return 1;
+	}
+	FESDRER_BENCH::Bench.json(f);
+	fclose(f);
+	return 0;
+}
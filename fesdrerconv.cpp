@@ -0,0 +1,63 @@
+/**
+ * fesdrerrand.h 输出格式的转换工具。
+ *
+ * 读入 RandomPrint 写出的数据（文本，print_graph_binary/print_graph_varint 的二进制边块，可以经过 gzip 或 zstd 压缩），
+ * 转回与 print_graph 相同的文本格式，用于把压缩后分发的测试数据导入评测系统。
+ *
+ * 编译：g++ -O2 -std=c++11 fesdrerconv.cpp -o fesdrerconv，需要解压时再加 -DFESDRER_USE_ZLIB -lz 或 -DFESDRER_USE_ZSTD -lzstd。
+ *
+ * 用法：fesdrerconv [输入文件 [输出文件]]，省略时使用标准输入输出。
+ *
+ * @author Fesdrer
+ */
+
+#include "fesdrerrand.h"
+#include <cstdio>
+#include <fcntl.h>
+
+
+int main(int argc,char **argv){
+	if(argc>3){
+		fprintf(stderr,"usage: %s [input [output]]\n",argv[0]);
+		return 2;
+	}
+#ifdef _WIN32
+	//Windows 下标准输入输出默认是文本模式，会改动二进制数据里的 \r\n 和 0x1A。
+	if(argc<2)	_setmode(_fileno(stdin),_O_BINARY);
+	if(argc<3)	_setmode(_fileno(stdout),_O_BINARY);
+#endif
+	FILE *in=argc>1?fopen(argv[1],"rb"):stdin;
+	if(!in){
+		fprintf(stderr,"cannot open %s\n",argv[1]);
+		return 1;
+	}
+	std::string data,text;
+	std::vector<char> buf(1<<20);
+	size_t k;
+	while((k=fread(buf.data(),1,buf.size(),in))>0)	data.append(buf.data(),k);
+	if(in!=stdin)	fclose(in);
+	if(!FESDRER_STL::decompress(data,text)){
+		fprintf(stderr,"cannot decompress the input: the data is broken, or rebuild with -DFESDRER_USE_ZLIB / -DFESDRER_USE_ZSTD\n");
+		return 1;
+	}
+	std::string().swap(data);
+	int fd=1;
+	if(argc>2){
+#ifdef _WIN32
+		fd=_open(argv[2],_O_WRONLY|_O_CREAT|_O_TRUNC|_O_BINARY,0644);
+#else
+		fd=open(argv[2],O_WRONLY|O_CREAT|O_TRUNC,0644);
+#endif
+		if(fd<0){
+			fprintf(stderr,"cannot open %s\n",argv[2]);
+			return 1;
+		}
+	}
+	FESDRER_STL::FWriter out(fd);
+	if(!FESDRER_STL::decode_text(text,out)){
+		fprintf(stderr,"broken edge block in the input\n");
+		return 1;
+	}
+	out.flush();
+	return 0;
+}
@@ -0,0 +1,826 @@
+/**
+ * 这是由 Fesdrer 独立编写的测试数据批量生成库，是 FesdrerIO.py 的 c++ 版本。
+ *
+ * 生成程序直接在进程内调用，输出写到内存里，标程通过管道运行，不经过临时文件。
+ *
+ * @param run 运行一个外部程序，通过管道给出输入、读取输出
+ *
+ * @param FCase 一个测试点的编号、种子和参数
+ *
+ * @param FPlan 一道题目的测试数据计划：参数、文件名、每一段测试点的生成函数，用多个线程批量生成
+ *
+ * @param FProfile 在生成的每个测试点上运行程序，测量时间和内存
+ *
+ * @param FStress 多线程对拍，找到按编号顺序第一个出错的测试点
+ *
+ * @param FTokenCompare 流式的按单词比较，边读程序输出边和标准答案比较
+ *
+ * @param FShrink 反例化简，缩小生成参数并删除输入中的项
+ *
+ * @author Fesdrer
+ */
+
+#ifndef FESDRERIO_H
+#define FESDRERIO_H 1
+
+
+#pragma GCC system_header
+
+
+#include "fesdrerrand.h"
+#include <map>
+#include <functional>
+#include <initializer_list>
+#include <cerrno>
+#include <climits>
+#include <unordered_map>
+#ifdef _WIN32
+#include <stdio.h>
+#else
+#include <poll.h>
+#include <fcntl.h>
+#include <signal.h>
+#include <sys/wait.h>
+#include <sys/resource.h>
+#include <sys/socket.h>
+#include <sys/uio.h>
+#endif
+
+
+namespace FESDRER_IO{
+	//运行一次外部程序的结果。
+	struct FRun{
+		int status;		//退出码，被信号结束时为 128+信号编号，无法运行时为 -1
+		bool timeout;	//是否因为超过时间限制被结束
+		bool stopped;	//是否因为 f 返回 false 被提前结束
+		double seconds;	//墙上时间
+		double cpu;		//用户态和内核态的 CPU 时间之和（秒），Windows 下等于墙上时间
+		long long memory;	//峰值内存（KB），Windows 下为 0
+	};
+
+
+#ifndef _WIN32
+	//创建管道和启动子进程时加锁，保证别的线程启动的子进程不会继承这里的管道，否则子进程的输入永远读不到结尾。
+	inline std::mutex& spawn_lock(){
+		static std::mutex lock;
+		return lock;
+	}
+	inline void set_flag(int fd,int cmd_get,int cmd_set,int flag){
+		fcntl(fd,cmd_set,fcntl(fd,cmd_get)|flag);
+	}
+
+
+	/*
+	子进程的峰值内存包含它从父进程复制来的部分：fork 复制的页表计入子进程的内存，vfork 时 exec 之前用的就是父进程的内存。
+	所以子进程不由本进程直接启动，而是由一个辅助进程启动。辅助进程在程序开始时（生成任何数据之前）从本进程 fork 出来，几乎不占内存。
+	本进程通过 socket 把命令和子进程的管道发给辅助进程，辅助进程为每个命令 fork 一个监视进程，监视进程再 fork 出子进程运行命令，
+	等本进程发来 k（结束程序）或 w（等待程序结束）后用 wait4 取得子进程的退出状态和 rusage，写回给本进程。
+	*/
+	struct FSpawnResult{
+		int status;
+		double cpu;
+		long long memory;
+	};
+	//监视进程。fd 依次为子进程的标准输入、标准输出、标准错误，写结果的管道和读 k/w 的管道。
+	inline void spawner_watch(const char *cmd,const int *fd){
+		signal(SIGCHLD,SIG_DFL);
+		FSpawnResult r;
+		r.status=-1,r.cpu=0,r.memory=0;
+		pid_t pid=fork();
+		if(!pid){
+			dup2(fd[0],0),dup2(fd[1],1),dup2(fd[2],2);
+			for(int i=0;i<5;i++)	if(fd[i]>2)	close(fd[i]);
+			signal(SIGPIPE,SIG_DFL);
+			setpgid(0,0);	//sh 不一定 exec 命令本身，结束时要结束整个进程组
+			execl("/bin/sh","sh","-c",cmd,(char*)nullptr);
+			_exit(127);
+		}
+		close(fd[0]),close(fd[1]),close(fd[2]);
+		if(pid>0){
+			setpgid(pid,pid);	//子进程可能还没来得及自己设置，这里也设置一次，保证下面 kill 时进程组已经存在
+			char c=0;
+			while(read(fd[4],&c,1)<0&&errno==EINTR);
+			if(c!='w')	kill(-pid,SIGKILL);
+			int st=0;
+			struct rusage ru;
+			memset(&ru,0,sizeof(ru));
+			while(wait4(pid,&st,0,&ru)<0&&errno==EINTR);
+			if(WIFEXITED(st))	r.status=WEXITSTATUS(st);
+			else if(WIFSIGNALED(st))	r.status=128+WTERMSIG(st);
+			r.cpu=ru.ru_utime.tv_sec+ru.ru_stime.tv_sec+(ru.ru_utime.tv_usec+ru.ru_stime.tv_usec)*1e-6;
+#ifdef __APPLE__
+			r.memory=ru.ru_maxrss/1024;
+#else
+			r.memory=ru.ru_maxrss;
+#endif
+		}
+		while(write(fd[3],&r,sizeof(r))<0&&errno==EINTR);
+		_exit(0);
+	}
+	//辅助进程：每收到一个命令就 fork 一个监视进程，本进程退出（socket 关闭）时退出。只用固定的缓冲区，不分配内存。
+	inline void spawner_loop(int sock){
+		static char cmd[1<<16];
+		signal(SIGCHLD,SIG_IGN);	//监视进程结束后自动回收
+		for(;;){
+			int fd[5];
+			unsigned len=0;
+			iovec io;
+			io.iov_base=&len,io.iov_len=sizeof(len);
+			union{cmsghdr h;char c[CMSG_SPACE(sizeof(fd))];} u;
+			msghdr msg;
+			memset(&msg,0,sizeof(msg));
+			msg.msg_iov=&io,msg.msg_iovlen=1,msg.msg_control=u.c,msg.msg_controllen=sizeof(u.c);
+			long long k=recvmsg(sock,&msg,0);
+			if(k<0&&errno==EINTR)	continue;
+			if(k!=sizeof(len))	_exit(0);
+			cmsghdr *h=CMSG_FIRSTHDR(&msg);
+			if(!h||h->cmsg_level!=SOL_SOCKET||h->cmsg_type!=SCM_RIGHTS||h->cmsg_len!=CMSG_LEN(sizeof(fd)))	_exit(0);
+			memcpy(fd,CMSG_DATA(h),sizeof(fd));
+			for(unsigned done=0;done<len;){
+				k=read(sock,cmd+done,len-done);
+				if(k<0&&errno==EINTR)	continue;
+				if(k<=0)	_exit(0);
+				done+=unsigned(k);
+			}
+			cmd[len]=0;
+			if(!fork())	close(sock),spawner_watch(cmd,fd);
+			for(int x:fd)	close(x);
+		}
+	}
+	//本进程一侧的 socket，辅助进程启动失败时为 -1。第一次调用时启动辅助进程。
+	inline int spawner(){
+		static int sock=[](){
+			int sv[2];
+			if(socketpair(AF_UNIX,SOCK_STREAM,0,sv))	return -1;
+			set_flag(sv[0],F_GETFD,F_SETFD,FD_CLOEXEC),set_flag(sv[1],F_GETFD,F_SETFD,FD_CLOEXEC);
+			pid_t pid=fork();
+			if(!pid)	close(sv[0]),spawner_loop(sv[1]);
+			close(sv[1]);
+			if(pid<0){close(sv[0]);return -1;}
+			return sv[0];
+		}();
+		return sock;
+	}
+	//在静态初始化时启动辅助进程，这时本进程还没有生成数据，也没有别的线程。
+	static const int spawner_started=spawner();
+	//把命令 cmd 和子进程要用的 5 个文件描述符发给辅助进程，调用时需持有 spawn_lock。
+	inline bool spawner_send(const std::string &cmd,const int *fd){
+		int sock=spawner();
+		unsigned len=unsigned(cmd.size());
+		if(sock<0||cmd.size()>=(1<<16))	return 0;
+		iovec io;
+		io.iov_base=&len,io.iov_len=sizeof(len);
+		union{cmsghdr h;char c[CMSG_SPACE(5*sizeof(int))];} u;
+		memset(&u,0,sizeof(u));
+		msghdr msg;
+		memset(&msg,0,sizeof(msg));
+		msg.msg_iov=&io,msg.msg_iovlen=1,msg.msg_control=u.c,msg.msg_controllen=sizeof(u.c);
+		cmsghdr *h=CMSG_FIRSTHDR(&msg);
+		h->cmsg_level=SOL_SOCKET,h->cmsg_type=SCM_RIGHTS,h->cmsg_len=CMSG_LEN(5*sizeof(int));
+		memcpy(CMSG_DATA(h),fd,5*sizeof(int));
+		long long k;
+		while((k=sendmsg(sock,&msg,0))<0&&errno==EINTR);
+		if(k!=sizeof(len))	return 0;
+		for(size_t done=0;done<cmd.size();){
+			k=::write(sock,cmd.data()+done,cmd.size()-done);
+			if(k<0&&errno==EINTR)	continue;
+			if(k<=0)	return 0;
+			done+=size_t(k);
+		}
+		return 1;
+	}
+#endif
+
+
+	/*
+	运行命令 cmd（Linux 下由 /bin/sh -c 解释），把 in 写入它的标准输入，每读到一段标准输出 [s,s+n) 就调用一次 f(s,n)。
+	f 返回 false 时立即结束程序。limit 大于 0 时超过 limit 秒也会结束程序。
+	输入输出用 poll 同时读写，不经过临时文件，程序的输出很大时也不会互相等待。程序由辅助进程启动并用 wait4 取得 CPU 时间和峰值内存，见 spawner。
+	Windows 下没有 poll，改为把输入写到临时文件再用 _popen 运行，不支持 limit。
+	*/
+	template<typename F> inline FRun run(const std::string &cmd,const std::string &in,F f,double limit=0){
+		FRun ret;
+		ret.status=-1,ret.timeout=0,ret.stopped=0,ret.seconds=0,ret.cpu=0,ret.memory=0;
+		std::chrono::steady_clock::time_point begin=std::chrono::steady_clock::now();
+		auto used=[&](){return std::chrono::duration<double>(std::chrono::steady_clock::now()-begin).count();};
+#ifdef _WIN32
+		char *tmp=_tempnam(nullptr,"fio");
+		if(!tmp)	return ret;
+		std::string name(tmp);
+		free(tmp);
+		FILE *file=fopen(name.c_str(),"wb");
+		if(!file)	return ret;
+		fwrite(in.data(),1,in.size(),file),fclose(file);
+		FILE *p=_popen((cmd+" < \""+name+"\"").c_str(),"rb");
+		if(p){
+			std::vector<char> buf(1<<16);
+			size_t k;
+			while((k=fread(buf.data(),1,buf.size(),p))>0)	if(!f((const char*)buf.data(),k)){ret.stopped=1;break;}
+			while(ret.stopped&&fread(buf.data(),1,buf.size(),p)>0);
+			ret.status=_pclose(p);
+		}
+		remove(name.c_str());
+		ret.seconds=ret.cpu=used();
+		return ret;
+#else
+		{
+			//写已经关闭的管道会收到 SIGPIPE，忽略它，让 write 返回错误。子进程中恢复默认处理。
+			static std::once_flag once;
+			std::call_once(once,[](){signal(SIGPIPE,SIG_IGN);});
+		}
+		int pin[2],pout[2],pres[2],pctl[2];
+		{
+			std::lock_guard<std::mutex> guard(spawn_lock());
+			if(pipe(pin))	return ret;
+			if(pipe(pout)){close(pin[0]),close(pin[1]);return ret;}
+			if(pipe(pres)){close(pin[0]),close(pin[1]),close(pout[0]),close(pout[1]);return ret;}
+			if(pipe(pctl)){close(pin[0]),close(pin[1]),close(pout[0]),close(pout[1]),close(pres[0]),close(pres[1]);return ret;}
+			for(int fd:{pin[0],pin[1],pout[0],pout[1],pres[0],pres[1],pctl[0],pctl[1]})	set_flag(fd,F_GETFD,F_SETFD,FD_CLOEXEC);
+			int child[5]={pin[0],pout[1],2,pres[1],pctl[0]};
+			bool ok=spawner_send(cmd,child);
+			close(pin[0]),close(pout[1]),close(pres[1]),close(pctl[0]);
+			if(!ok){close(pin[1]),close(pout[0]),close(pres[0]),close(pctl[1]);return ret;}
+		}
+		set_flag(pin[1],F_GETFL,F_SETFL,O_NONBLOCK);
+		size_t done=0;
+		int wfd=pin[1],rfd=pout[0];
+		if(in.empty())	close(wfd),wfd=-1;
+		std::vector<char> buf(1<<16);
+		while(rfd>=0){
+			pollfd p[2];
+			int k=0;
+			p[k].fd=rfd,p[k].events=POLLIN,p[k].revents=0,k++;
+			if(wfd>=0)	p[k].fd=wfd,p[k].events=POLLOUT,p[k].revents=0,k++;
+			int wait=-1;
+			if(limit>0){
+				double rest=limit-used();
+				if(rest<=0){ret.timeout=1;break;}
+				wait=int(rest*1000)+1;
+			}
+			if(poll(p,k,wait)<0){
+				if(errno==EINTR)	continue;
+				break;
+			}
+			if(wfd>=0&&p[1].revents){
+				long long w=::write(wfd,in.data()+done,std::min<size_t>(in.size()-done,1<<16));
+				if(w>0)	done+=size_t(w);
+				if(w<0&&errno!=EAGAIN&&errno!=EINTR)	done=in.size();
+				if(done==in.size())	close(wfd),wfd=-1;
+			}
+			if(p[0].revents){
+				long long r=::read(rfd,buf.data(),buf.size());
+				if(r<0&&(errno==EAGAIN||errno==EINTR))	continue;
+				if(r<=0){close(rfd),rfd=-1;break;}
+				if(!f((const char*)buf.data(),size_t(r))){ret.stopped=1;break;}
+			}
+		}
+		if(wfd>=0)	close(wfd);
+		char c=rfd>=0?'k':'w';
+		if(rfd>=0)	close(rfd);
+		while(::write(pctl[1],&c,1)<0&&errno==EINTR);
+		close(pctl[1]);
+		FSpawnResult r;
+		size_t got=0;
+		while(got<sizeof(r)){
+			long long k=::read(pres[0],(char*)&r+got,sizeof(r)-got);
+			if(k<0&&errno==EINTR)	continue;
+			if(k<=0)	break;
+			got+=size_t(k);
+		}
+		close(pres[0]);
+		ret.seconds=used();
+		if(got==sizeof(r))	ret.status=r.status,ret.cpu=r.cpu,ret.memory=r.memory;
+		return ret;
+#endif
+	}
+	//运行命令 cmd，输入为 in，输出追加到 out 的末尾。
+	inline FRun run(const std::string &cmd,const std::string &in,std::string &out,double limit=0){
+		return run(cmd,in,[&](const char *s,size_t n){out.append(s,n);return true;},limit);
+	}
+
+
+	//把字符串 s 写到文件 name，成功返回 true。
+	inline bool write_file(const std::string &name,const std::string &s){
+		FILE *f=fopen(name.c_str(),"wb");
+		if(!f)	return 0;
+		bool ok=fwrite(s.data(),1,s.size(),f)==s.size();
+		return fclose(f)==0&&ok;
+	}
+	//读出文件 name 的全部内容到 s，成功返回 true。
+	inline bool read_file(const std::string &name,std::string &s){
+		FILE *f=fopen(name.c_str(),"rb");
+		if(!f)	return 0;
+		s.clear();
+		std::vector<char> buf(1<<16);
+		size_t k;
+		while((k=fread(buf.data(),1,buf.size(),f))>0)	s.append(buf.data(),k);
+		bool ok=!ferror(f);
+		fclose(f);
+		return ok;
+	}
+
+
+	/*
+	一个测试点。params 对应 FesdrerIO.py 中 IOData 的 datanumber，每个参数是一个数或者一组数（如数据范围的上下界）。
+	seed 由计划的种子和测试点编号决定，生成前会用它设置当前线程的随机种子，所以每个测试点都可以单独复现。
+	*/
+	class FCase{
+	public:
+		int id;
+		unsigned long long seed;
+		std::map<std::string,std::vector<long long>> params;
+		//参数 name 的第 i 个数。
+		inline long long operator()(const std::string &name,int i=0) const{
+			std::map<std::string,std::vector<long long>>::const_iterator it=params.find(name);
+			assert(it!=params.end()&&i<int(it->second.size()));
+			return it->second[i];
+		}
+	};
+	//测试点的生成函数，通过 RandomPrint 或 FESDRER_RAND::fout 输出。
+	typedef std::function<void(const FCase&)> FGenerator;
+
+
+	//种子为 seed 的计划中编号为 id 的测试点的种子。
+	inline unsigned long long case_seed(unsigned long long seed,long long id){
+		unsigned long long sd=seed+(unsigned long long)id;
+		return FESDRER_RAND::splitmix64(sd);
+	}
+	/*
+	在当前线程中用 gen 生成测试点 c 的输入：先用 c.seed 设置随机种子，再让 fout 写到返回的字符串。
+	parallel_for 总有一部分测试点在调用者的线程中运行，这时 fout 和 rng_64 都是调用者的。所以先把 fout 原来的状态（输出目标、没写出的内容、压缩流）换出来，
+	并保存 rng_64，结束时（包括 gen 抛出异常时）原样恢复，调用者的重定向、压缩和随机数序列都不受影响，与线程怎样分配测试点无关。
+	*/
+	inline std::string generate(const FGenerator &gen,const FCase &c){
+		struct Guard{
+			FESDRER_STL::FWriter saved;
+			FESDRER_RAND::FEngine rng;
+			inline Guard():rng(FESDRER_RAND::rng_64){FESDRER_RAND::fout.swap(saved);}
+			inline ~Guard(){FESDRER_RAND::fout.swap(saved),FESDRER_RAND::rng_64=rng;}
+		};
+		std::string ret;
+		Guard guard;
+		FESDRER_RAND::fout.redirect(&ret);
+		FESDRER_RAND::random_seed(c.seed);
+		gen(c);
+		FESDRER_RAND::fout.flush();
+		return ret;
+	}
+
+
+	//一个测试点的生成结果。
+	struct FResult{
+		int id;
+		unsigned long long seed;
+		size_t in_bytes,ans_bytes;
+		FRun std_run;	//标程的运行结果
+		bool ok;	//文件都写成功且标程正常结束
+	};
+
+
+	/*
+	一道题目的测试数据计划，代替 FesdrerIO.py 中的 IOData 和 IO。
+	用 param 设置默认参数，用 add 给一段编号的测试点指定生成函数和要改变的参数，最后调用 run 生成所有测试点。
+	输入在进程内生成：生成函数在工作线程中运行，fout 被重定向到一个字符串。生成函数不能直接使用 std::cout 或 printf。
+	*/
+	class FPlan{
+	private:
+		struct Group{
+			int l,r;
+			FGenerator gen;
+			std::map<std::string,std::vector<long long>> change;
+		};
+		std::map<std::string,std::vector<long long>> base;
+		std::vector<Group> groups;
+	public:
+		std::string name;		//题目名称，测试点文件名为 name+编号+后缀
+		std::string std_cmd;	//标程的命令，为空时只生成输入文件
+		std::string in_suffix,ans_suffix;
+		int width;				//编号的最少位数，不足时补 0，对应 FesdrerIO.py 的 rangestr
+		int threads;
+		unsigned long long seed;
+		double limit;			//标程的时间限制（秒），0 表示不限制
+		inline FPlan(const std::string &name,const std::string &std_cmd,int width=1):
+			name(name),std_cmd(std_cmd),in_suffix(".in"),ans_suffix(".ans"),width(width),
+			threads(std::max(1,int(std::thread::hardware_concurrency()))),seed(0),limit(0){}
+		//设置默认参数 key 为 v，例如 param("n",{1,100000})。
+		inline FPlan& param(const std::string &key,const std::vector<long long> &v){
+			base[key]=v;
+			return *this;
+		}
+		//编号在 [l,r] 中的测试点由 gen 生成，参数在默认参数的基础上用 change 覆盖，对应 IOData.NumberChange。
+		inline FPlan& add(int l,int r,FGenerator gen,const std::map<std::string,std::vector<long long>> &change=std::map<std::string,std::vector<long long>>()){
+			Group g;
+			g.l=l,g.r=r,g.gen=gen,g.change=change;
+			groups.push_back(g);
+			return *this;
+		}
+		//编号为 id 的测试点的文件名。
+		inline std::string file(int id,const std::string &suffix) const{
+			char s[32];
+			snprintf(s,sizeof(s),"%0*d",width,id);
+			return name+s+suffix;
+		}
+		//所有测试点，按 add 的顺序。
+		inline std::vector<FCase> cases() const{
+			std::vector<FCase> ret(0);
+			for(const Group &g:groups)	for(int id=g.l;id<=g.r;id++){
+				FCase c;
+				c.id=id,c.seed=case_seed(seed,id),c.params=base;
+				for(const std::pair<const std::string,std::vector<long long>> &i:g.change)	c.params[i.first]=i.second;
+				ret.push_back(c);
+			}
+			return ret;
+		}
+		//在当前线程中生成测试点 c 的输入。
+		inline std::string input(const FCase &c) const{
+			const Group *g=nullptr;
+			for(const Group &i:groups)	if(i.l<=c.id&&c.id<=i.r)	g=&i;
+			assert(g);
+			return generate(g->gen,c);
+		}
+		/*
+		用 threads 个线程生成所有测试点并写入文件，返回每个测试点的结果。
+		每个线程依次取一个测试点：进程内生成输入，通过管道运行标程得到答案，再写出两个文件。
+		*/
+		inline std::vector<FResult> run() const{
+			std::vector<FCase> all=cases();
+			std::vector<FResult> ret(all.size());
+			FESDRER_STL::parallel_for(int(all.size()),threads,[&](int i){
+				const FCase &c=all[i];
+				FResult &r=ret[i];
+				std::string in=input(c),ans;
+				r.id=c.id,r.seed=c.seed,r.in_bytes=in.size(),r.ans_bytes=0;
+				r.std_run.status=0,r.std_run.timeout=0,r.std_run.stopped=0,r.std_run.seconds=r.std_run.cpu=0,r.std_run.memory=0;
+				r.ok=write_file(file(c.id,in_suffix),in);
+				if(std_cmd.empty())	return;
+				r.std_run=FESDRER_IO::run(std_cmd,in,ans,limit);
+				r.ans_bytes=ans.size();
+				r.ok=r.ok&&r.std_run.status==0&&!r.std_run.timeout&&write_file(file(c.id,ans_suffix),ans);
+			});
+			return ret;
+		}
+	};
+
+
+	/*
+	流式的按单词比较：构造时给出标准答案 ref，之后把另一份输出分段交给 feed，忽略空白字符的差别逐个单词比较。
+	发现不同时 feed 立即返回 false，token 为第一个不同的单词的编号（从 1 开始），不需要等程序输出完。
+	ref 只保存引用，比较结束前不能修改或销毁。
+	*/
+	class FTokenCompare{
+	private:
+		const std::string &ref;
+		size_t pos;
+		bool in_token,bad;
+		static inline bool blank(char c){
+			return c==' '||c=='\n'||c=='\r'||c=='\t'||c=='\v'||c=='\f';
+		}
+	public:
+		long long token;
+		inline explicit FTokenCompare(const std::string &ref):ref(ref),pos(0),in_token(0),bad(0),token(0){}
+		inline bool feed(const char *s,size_t n){
+			for(size_t i=0;i<n&&!bad;i++){
+				if(blank(s[i])){
+					if(in_token&&pos<ref.size()&&!blank(ref[pos]))	bad=1;
+					in_token=0;
+				}
+				else{
+					if(!in_token){
+						while(pos<ref.size()&&blank(ref[pos]))	pos++;
+						in_token=1,token++;
+					}
+					if(pos>=ref.size()||ref[pos]!=s[i])	bad=1;
+					else	pos++;
+				}
+			}
+			return !bad;
+		}
+		//输出结束，返回两份输出是否相同。
+		inline bool finish(){
+			if(bad)	return 0;
+			if(in_token&&pos<ref.size()&&!blank(ref[pos]))	return bad=1,0;
+			while(pos<ref.size()&&blank(ref[pos]))	pos++;
+			if(pos<ref.size())	token++,bad=1;
+			return !bad;
+		}
+	};
+
+
+	//一个测试点的性能测试结果，时间和内存都是 runs 中各次运行的中位数。
+	struct FProfileCase{
+		FCase c;
+		size_t in_bytes;
+		std::vector<FRun> runs;
+		double wall,cpu;
+		long long memory;		//峰值内存（KB）
+		std::string verdict;	//OK、WA（有答案文件且输出不同）、RE、TLE（CPU 时间或墙上时间超过 limit）或 MLE（峰值内存超过 memory_limit），按第一次不正常的运行
+	};
+
+
+	/*
+	在 plan 的每个测试点上运行程序 cmd，测量墙上时间、CPU 时间和峰值内存（Linux 下取自 wait4 的 rusage），代替 FesdrerIO.py 中的 CheckIO。
+	每个测试点运行 repeat 次取中位数。输入读 plan 写出的文件，文件不存在时在进程内重新生成；答案文件存在时同时逐个单词检查输出。
+	同时运行的程序会互相影响计时，所以默认只用一个线程。dump 输出每个测试点离时间和内存限制有多近，并列出最慢的测试点和生成它们的参数。
+	程序由 run 的辅助进程启动，测得的内存只是程序自己的，与本进程生成数据用了多少内存无关。
+	*/
+	class FProfile{
+	private:
+		template<typename T> static inline T median(std::vector<T> a){
+			std::nth_element(a.begin(),a.begin()+a.size()/2,a.end());
+			return a[a.size()/2];
+		}
+		static inline std::string params(const FCase &c){
+			std::string ret;
+			for(const std::pair<const std::string,std::vector<long long>> &p:c.params){
+				ret+=(ret.empty()?"":" ")+p.first+"=";
+				for(size_t i=0;i<p.second.size();i++)	ret+=(i?",":"")+std::to_string(p.second[i]);
+			}
+			return ret;
+		}
+	public:
+		const FPlan &plan;
+		std::string cmd;
+		int repeat,threads;
+		double limit;			//时间限制（秒），超过时判为 TLE，运行超过 2*limit 秒时结束程序。0 表示不限制
+		long long memory_limit;	//内存限制（KB），超过时判为 MLE，不会因此结束程序。0 表示不限制
+		inline FProfile(const FPlan &plan,const std::string &cmd,int repeat=1):
+			plan(plan),cmd(cmd),repeat(std::max(1,repeat)),threads(1),limit(0),memory_limit(0){}
+		//运行所有测试点，按 plan.cases() 的顺序返回结果。
+		inline std::vector<FProfileCase> run() const{
+			std::vector<FCase> all=plan.cases();
+			std::vector<FProfileCase> ret(all.size());
+			FESDRER_STL::parallel_for(int(all.size()),threads,[&](int i){
+				FProfileCase &r=ret[i];
+				std::string in,ans;
+				r.c=all[i],r.verdict="OK";
+				if(!read_file(plan.file(r.c.id,plan.in_suffix),in))	in=plan.input(r.c);
+				bool has_ans=read_file(plan.file(r.c.id,plan.ans_suffix),ans);
+				r.in_bytes=in.size();
+				std::vector<double> wall(0),cpu(0);
+				std::vector<long long> memory(0);
+				for(int k=0;k<repeat;k++){
+					FTokenCompare cmp(ans);
+					bool same=1;
+					FRun x=FESDRER_IO::run(cmd,in,[&](const char *s,size_t n){if(same&&has_ans)	same=cmp.feed(s,n);return true;},2*limit);
+					same=same&&(!has_ans||cmp.finish());
+					bool tle=x.timeout||(limit>0&&(x.cpu>limit||x.seconds>limit)),mle=memory_limit>0&&x.memory>memory_limit;
+					if(r.verdict=="OK")	r.verdict=tle?"TLE":mle?"MLE":x.status?"RE":same?"OK":"WA";
+					r.runs.push_back(x),wall.push_back(x.seconds),cpu.push_back(x.cpu),memory.push_back(x.memory);
+				}
+				r.wall=median(wall),r.cpu=median(cpu),r.memory=median(memory);
+			});
+			return ret;
+		}
+		//按 CPU 时间从大到小排列的前 k 个测试点在 r 中的下标。
+		static inline std::vector<int> slowest(const std::vector<FProfileCase> &r,int k){
+			std::vector<int> id(r.size());
+			for(int i=0;i<int(r.size());i++)	id[i]=i;
+			std::stable_sort(id.begin(),id.end(),[&](int x,int y){return r[x].cpu>r[y].cpu;});
+			id.resize(std::min<size_t>(id.size(),std::max(k,0)));
+			return id;
+		}
+		//以表格形式输出每个测试点的结果，时间和内存后面是占限制的百分比，最慢的 top 个测试点用 * 标出，最后列出它们的参数。
+		inline void dump(const std::vector<FProfileCase> &r,int top=5,FILE *f=stderr) const{
+			std::vector<int> slow=slowest(r,top);
+			std::vector<char> mark(r.size(),0);
+			for(int i:slow)	mark[i]=1;
+			fprintf(f,"%-24s %12s %10s %10s %7s %12s %7s %8s\n","case","input","wall","cpu","time%","memory(KB)","mem%","verdict");
+			for(size_t i=0;i<r.size();i++){
+				fprintf(f,"%-24s %12zu %10.3f %10.3f ",plan.file(r[i].c.id,plan.in_suffix).c_str(),r[i].in_bytes,r[i].wall,r[i].cpu);
+				if(limit>0)	fprintf(f,"%6.1f%% ",100*r[i].cpu/limit);
+				else	fprintf(f,"%7s ","-");
+				fprintf(f,"%12lld ",r[i].memory);
+				if(memory_limit>0)	fprintf(f,"%6.1f%% ",100.0*r[i].memory/memory_limit);
+				else	fprintf(f,"%7s ","-");
+				fprintf(f,"%8s%s\n",r[i].verdict.c_str(),mark[i]?" *":"");
+			}
+			fprintf(f,"slowest:\n");
+			for(int i:slow)	fprintf(f,"  %s cpu %.3f s, seed %llu, %s\n",plan.file(r[i].c.id,plan.in_suffix).c_str(),r[i].cpu,r[i].c.seed,params(r[i].c).c_str());
+			fflush(f);
+		}
+	};
+
+
+	//对拍的结果。found 为 false 时表示在限制内没有找到反例。
+	struct FFailure{
+		bool found;
+		FCase c;			//出错的测试点，c.id 是第几次对拍（从 0 开始），c.seed 可以用来复现
+		std::string in,ans,out;	//输入、标程的输出、待测程序的输出（出错后被提前结束时只有一部分）
+		std::string reason;
+		long long iterations;	//一共完成的对拍次数
+		double seconds;
+	};
+
+
+	/*
+	多线程对拍，代替 FesdrerIO.py 中的 IOData.CreateCheck。
+	每个线程反复地取下一个编号 i，以 case_seed(seed,i) 为种子在进程内生成输入，通过管道分别交给标程和待测程序，
+	待测程序的输出边读边用 FTokenCompare 和标程的输出比较，第一个不同的单词出现时就结束它。
+	找到反例后不再开始新的对拍，编号更大的正在运行的对拍也会被结束，编号更小的会做完，
+	所以返回的总是按编号顺序第一个出错的测试点，与线程数无关，用 c.seed 和 generate 就能复现。
+	*/
+	class FStress{
+	private:
+		std::map<std::string,std::vector<long long>> base;
+	public:
+		FGenerator gen;
+		std::string std_cmd,wrong_cmd;
+		int threads;
+		unsigned long long seed;
+		double limit;			//两个程序各自的时间限制（秒），0 表示不限制，待测程序超时也算出错
+		long long max_iter;		//最多对拍的次数，0 表示不限制
+		double max_time;		//最长对拍时间（秒），0 表示不限制
+		inline FStress(FGenerator gen,const std::string &std_cmd,const std::string &wrong_cmd):
+			gen(gen),std_cmd(std_cmd),wrong_cmd(wrong_cmd),threads(std::max(1,int(std::thread::hardware_concurrency()))),
+			seed(0),limit(0),max_iter(0),max_time(0){}
+		//设置参数 key 为 v，与 FPlan::param 相同。
+		inline FStress& param(const std::string &key,const std::vector<long long> &v){
+			base[key]=v;
+			return *this;
+		}
+		//第 i 次对拍的测试点。
+		inline FCase make(long long i) const{
+			FCase c;
+			c.id=int(i),c.seed=case_seed(seed,i),c.params=base;
+			return c;
+		}
+		/*
+		用 in 对拍一次，两个程序的输出写到 ans 和 out，相同时返回空串，否则返回出错原因。
+		stop 返回 true 时提前结束，此时返回值没有意义。
+		*/
+		template<typename S> inline std::string check(const std::string &in,std::string &ans,std::string &out,S stop) const{
+			FRun a=FESDRER_IO::run(std_cmd,in,[&](const char *s,size_t n){ans.append(s,n);return !stop();},limit);
+			if(a.stopped)	return "stopped";
+			if(a.timeout)	return "std: time limit exceeded";
+			if(a.status)	return "std: exit code "+std::to_string(a.status);
+			FTokenCompare cmp(ans);
+			FRun b=FESDRER_IO::run(wrong_cmd,in,[&](const char *s,size_t n){
+				out.append(s,n);
+				return cmp.feed(s,n)&&!stop();
+			},limit);
+			if(b.stopped&&stop())	return "stopped";
+			if(b.timeout)	return "time limit exceeded";
+			if(!b.stopped&&b.status)	return "exit code "+std::to_string(b.status);
+			if(!cmp.finish())	return "wrong answer on token "+std::to_string(cmp.token);
+			return "";
+		}
+		//开始对拍，直到找到反例或达到 max_iter、max_time。
+		inline FFailure run() const{
+			FFailure ret;
+			ret.found=0,ret.iterations=0,ret.seconds=0;
+			std::chrono::steady_clock::time_point begin=std::chrono::steady_clock::now();
+			auto used=[&](){return std::chrono::duration<double>(std::chrono::steady_clock::now()-begin).count();};
+			std::atomic<long long> next(0),best(LLONG_MAX),done(0);
+			std::mutex lock;
+			FESDRER_STL::parallel_for(threads,threads,[&](int){
+				while(1){
+					long long i=next++;
+					if(i>=best.load()||(max_iter&&i>=max_iter)||(max_time>0&&used()>max_time))	break;
+					FCase c=make(i);
+					std::string in=generate(gen,c),ans,out;
+					std::string why=check(in,ans,out,[&](){return i>best.load();});
+					if(why=="stopped")	continue;
+					done++;
+					if(why.empty())	continue;
+					std::lock_guard<std::mutex> guard(lock);
+					if(i<best.load()){
+						best=i;
+						ret.found=1,ret.c=c,ret.reason=why;
+						ret.in.swap(in),ret.ans.swap(ans),ret.out.swap(out);
+					}
+				}
+			});
+			ret.iterations=done.load(),ret.seconds=used();
+			return ret;
+		}
+	};
+
+
+	/*
+	反例化简。先缩小生成参数，再直接删除输入中的项，得到一个仍然出错、尽量小的输入。
+	1. 参数：每个参数的每个数依次尝试向 0 靠近（0，一半，四分之三……），每组参数用原来的种子和另外 tries-1 个种子生成，
+	   只要有一个种子出错就接受。valid 可以用 RandomGraph.check 等函数排除不合法的参数，避免生成函数中的 assert 失败。
+	2. 输入：前 head 行原样保留，其余每行是一项（如一条边），用 delta debugging（ddmin）删除项，剩下的项用 join 拼回输入。
+	   项数写在输入里时（如边数 m），要提供 join 重新写出第一行。
+	同一轮的候选输入用 threads 个线程并行运行，按顺序取第一个出错的，所以结果与线程数无关。
+	运行过的输入以输入本身为键记录结果，不会重复运行。只有待测程序出错才算出错，标程出错的输入视为不合法。
+	*/
+	class FShrink{
+	private:
+		const FStress &st;
+		std::unordered_map<std::string,bool> cache;	//以输入本身为键，只用哈希值的话碰撞时会拿到别的输入的结果
+		std::mutex lock;
+		//对每个候选 i 调用 make(i) 得到输入，返回第一个出错的候选的编号，都不出错返回 -1。
+		template<typename M> inline int first(int n,M make){
+			int batch=std::max(1,st.threads);
+			for(int l=0;l<n;l+=batch){
+				int r=std::min(n,l+batch);
+				std::vector<char> bad(r-l,0);
+				FESDRER_STL::parallel_for(r-l,st.threads,[&](int i){bad[i]=fails(make(l+i));});
+				for(int i=l;i<r;i++)	if(bad[i-l])	return i;
+			}
+			return -1;
+		}
+	public:
+		std::function<bool(const FCase&)> valid;
+		int tries;	//每组参数尝试的种子数
+		int head;	//输入中不参与删除的行数
+		std::function<std::string(const std::string&,const std::vector<std::string>&)> join;
+		long long tests;	//实际运行的次数
+		inline explicit FShrink(const FStress &st):st(st),valid([](const FCase&){return true;}),tries(4),head(1),tests(0){
+			join=[](const std::string &h,const std::vector<std::string> &items){
+				std::string ret=h;
+				for(const std::string &i:items)	ret+=i,ret+='\n';
+				return ret;
+			};
+		}
+		//输入 in 是否让待测程序出错。
+		inline bool fails(const std::string &in){
+			{
+				std::lock_guard<std::mutex> guard(lock);
+				std::unordered_map<std::string,bool>::iterator it=cache.find(in);
+				if(it!=cache.end())	return it->second;
+				tests++;
+			}
+			std::string ans,out,why=st.check(in,ans,out,[](){return false;});
+			bool ret=!why.empty()&&why.compare(0,4,"std:")!=0;
+			std::lock_guard<std::mutex> guard(lock);
+			cache[in]=ret;
+			return ret;
+		}
+		//缩小出错的测试点 c 的参数和种子，返回仍然出错的测试点。
+		inline FCase params(FCase c){
+			bool changed=1;
+			while(changed){
+				changed=0;
+				std::vector<std::string> keys(0);
+				for(const std::pair<const std::string,std::vector<long long>> &p:c.params)	keys.push_back(p.first);
+				for(const std::string &key:keys)	for(size_t k=0;k<c.params[key].size();k++){
+					long long v=c.params[key][k];
+					std::vector<long long> cand(0);
+					for(long long d=v;d;d/=2)	cand.push_back(v-d);
+					std::vector<FCase> now(0);
+					for(long long x:cand){
+						FCase t=c;
+						t.params[key][k]=x;
+						if(!valid(t))	continue;
+						for(int j=0;j<tries;j++){
+							if(j)	t.seed=case_seed(c.seed,j);
+							now.push_back(t);
+						}
+					}
+					int i=first(int(now.size()),[&](int i){return generate(st.gen,now[i]);});
+					if(i>=0)	c=now[i],changed=1;
+				}
+			}
+			return c;
+		}
+		//用 ddmin 删除输入 in 中的项，返回仍然出错的输入。
+		inline std::string items(const std::string &in){
+			std::string h;
+			std::vector<std::string> cur(0);
+			size_t pos=0;
+			for(int line=0;pos<in.size();line++){
+				size_t e=in.find('\n',pos);
+				if(e==std::string::npos)	e=in.size();
+				if(line<head)	h.append(in,pos,e+1-pos);
+				else if(e>pos)	cur.push_back(in.substr(pos,e-pos));
+				pos=e+1;
+			}
+			if(!fails(join(h,cur)))	return in;
+			int n=2;
+			while(cur.size()>=2){
+				n=std::min<int>(n,int(cur.size()));
+				std::vector<size_t> cut(n+1);
+				for(int i=0;i<=n;i++)	cut[i]=cur.size()*i/n;
+				//前 n 个候选只保留一块，后 n 个候选删掉一块。
+				auto part=[&](int i){
+					std::vector<std::string> ret(0);
+					if(i<n)	ret.assign(cur.begin()+cut[i],cur.begin()+cut[i+1]);
+					else	ret.assign(cur.begin(),cur.begin()+cut[i-n]),ret.insert(ret.end(),cur.begin()+cut[i-n+1],cur.end());
+					return ret;
+				};
+				int i=first(2*n,[&](int i){return join(h,part(i));});
+				if(i>=0&&i<n)	cur=part(i),n=2;
+				else if(i>=n)	cur=part(i),n=std::max(n-1,2);
+				else if(n>=int(cur.size()))	break;
+				else	n=std::min(2*n,int(cur.size()));
+			}
+			return join(h,cur);
+		}
+		//依次缩小参数和输入，返回化简后的反例。f 为 FStress::run 找到的反例。
+		inline FFailure run(const FFailure &f){
+			FFailure ret=f;
+			if(!f.found)	return ret;
+			ret.c=params(f.c);
+			std::string in=generate(st.gen,ret.c);
+			if(!fails(in))	in=f.in,ret.c=f.c;
+			ret.in=items(in),ret.ans.clear(),ret.out.clear();
+			ret.reason=st.check(ret.in,ret.ans,ret.out,[](){return false;});
+			return ret;
+		}
+	};
+}
+
+
+#endif
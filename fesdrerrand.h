@@ -3,7 +3,7 @@
  * 
  * 能够方便进行信息学奥林匹克竞赛（OI）中的测试数据生成及对拍工作。
  * 
- * @param FVector 这是用平衡树实现的 vector，与传统的 vector 相比对 insert 和 erase 进行了提速
+ * @param FVector 这是分块实现的 vector，与传统的 vector 相比对 insert 和 erase 进行了提速
  * 
  * @param random 这是最基本的随机整数生成器
  * 
@@ -31,60 +31,100 @@
 
 #include <iostream>
 #include <cstring>
+#include <cmath>
 #include <chrono>
 #include <unordered_set>
+#include <map>
+#include <climits>
 #include <random>
 #include <queue>
 #include <stack>
 #include <algorithm>
+#include <thread>
+#include <atomic>
+#include <sstream>
+#include <type_traits>
+#include <mutex>
+#include <string>
+#include <functional>
+#include <cstdio>
 #include <assert.h>
+#ifdef _WIN32
+#include <io.h>
+#include <fcntl.h>
+#else
+#include <unistd.h>
+#include <fcntl.h>
+#include <sys/mman.h>
+#endif
+#ifdef FESDRER_USE_ZLIB
+#include <zlib.h>
+#endif
+#ifdef FESDRER_USE_ZSTD
+#include <zstd.h>
+#endif
 
 
 namespace FESDRER_STL{
+	/*
+	分块实现的 vector，与传统的 vector 相比对 insert 和 erase 进行了提速。
+	元素按顺序存放在若干个长度约为 B 的块里，块的长度用树状数组维护，下标访问、插入、删除都只需要一次树状数组上的二分和块内的移动。
+	*/
 	class FVector{
 	private:
-		struct TreeNode{int ls,rs,val,randnum,siz;};
-		std::vector<TreeNode> tr;
-		int root;
-		inline int New(int val){
-			tr.push_back((TreeNode){0,0,val,rand(),1});
-			return int(tr.size())-1;
-		}
-		inline void pushup(int p){
-			tr[p].siz=tr[tr[p].ls].siz+tr[tr[p].rs].siz+1;
-		}
-		inline void split(int p,int key,int &pr,int &qr){
-			if(!p){
-				pr=qr=0;
-				return;
+		enum{B=512};
+		std::vector<std::vector<int>> blk;
+		std::vector<int> fen;
+		int total;
+		inline void rebuild(){
+			int nb=int(blk.size());
+			fen.assign(nb+1,0);
+			for(int i=1;i<=nb;i++){
+				fen[i]+=int(blk[i-1].size());
+				int j=i+(i&-i);
+				if(j<=nb)	fen[j]+=fen[i];
 			}
-			if(tr[tr[p].ls].siz+1<=key)	pr=p,split(tr[p].rs,key-tr[tr[p].ls].siz-1,tr[p].rs,qr);
-			else	qr=p,split(tr[p].ls,key,pr,tr[p].ls);
-			pushup(p);
 		}
-		inline int merge(int p,int q){
-			if(!p||!q)  return p|q;
-			if(tr[p].randnum>tr[q].randnum){
-				tr[p].rs=merge(tr[p].rs,q);
-				pushup(p);
-				return p;
-			}
-			else{
-				tr[q].ls=merge(p,tr[q].ls);
-				pushup(q);
-				return q;
+		inline void add(int b,int d){
+			for(int i=b+1;i<int(fen.size());i+=i&-i)	fen[i]+=d;
+		}
+		inline int prefix(int b){
+			int ret=0;
+			for(int i=b;i;i-=i&-i)	ret+=fen[i];
+			return ret;
+		}
+		//找到下标 index 所在的块，index 变为块内的下标。
+		inline int locate(int &index){
+			int nb=int(blk.size()),pos=0,step=1;
+			while(step*2<=nb)	step<<=1;
+			for(;step;step>>=1)	if(pos+step<=nb&&fen[pos+step]<=index)	pos+=step,index-=fen[pos];
+			return pos;
+		}
+		template<typename T> inline void build(T first,T last){
+			blk.clear(),total=0;
+			while(first!=last){
+				blk.push_back(std::vector<int>(0));
+				blk.back().reserve(2*B);
+				for(int i=0;i<B&&first!=last;i++,first++)	blk.back().push_back(*first),total++;
 			}
+			rebuild();
 		}
 	public:
 		inline void clear(){
-			root=0,tr.assign(1,(TreeNode){0,0,0,0,0});
+			blk.clear(),fen.assign(1,0),total=0;
 		}
 		inline void assign(int n,int val=0){
-			root=0,tr.assign(1,(TreeNode){0,0,0,0,0});
-			if(n>0){
-				root=New(val),n--;
-				while(n--)	root=merge(root,New(val));
+			clear();
+			while(n>0){
+				int k=std::min(n,int(B));
+				blk.push_back(std::vector<int>(k,val)),blk.back().reserve(2*B);
+				n-=k,total+=k;
 			}
+			rebuild();
+		}
+		//用 [first,last) 中的元素构造，O(n)。
+		template<typename T> inline void assign(T first,T last){
+			build(first,last);
 		}
 		inline FVector(){
 			clear();
@@ -92,50 +132,1031 @@ namespace FESDRER_STL{
 		inline FVector(int n,int val=0){
 			assign(n,val);
 		}
-		inline int size(){
-			return tr[root].siz;
+		template<typename T,typename=typename std::enable_if<!std::is_integral<T>::value>::type> inline FVector(T first,T last){
+			build(first,last);
+		}
+		inline int size() const{
+			return total;
 		}
 		inline void push_back(int val){
-			root=merge(root,New(val));
+			if(blk.empty()||int(blk.back().size())>=2*B){
+				blk.push_back(std::vector<int>(1,val)),blk.back().reserve(2*B);
+				total++,rebuild();
+				return;
+			}
+			blk.back().push_back(val),total++,add(int(blk.size())-1,1);
 		}
 		int& operator[](int index){
-			index++;
-			int p=root;
-			while(p){
-				if(tr[tr[p].ls].siz+1==index)	return tr[p].val;
-				else if(tr[tr[p].ls].siz>=index)	p=tr[p].ls;
-				else	index-=1+tr[tr[p].ls].siz,p=tr[p].rs;
-			}
-			return tr[root].val;
+			int b=locate(index);
+			return blk[b][index];
 		}
 		inline void erase(int index){
-			int p,mid,q;
-			split(root,index,p,q);
-			split(q,1,mid,q);
-			root=merge(p,q);
+			int b=locate(index);
+			blk[b].erase(blk[b].begin()+index),total--;
+			if(blk[b].empty())	blk.erase(blk.begin()+b),rebuild();
+			else	add(b,-1);
 		}
 		inline void insert(int index,int val){
-			int p,q;
-			split(root,index,p,q);
-			root=merge(merge(p,New(val)),q);
+			if(index>=total){
+				push_back(val);
+				return;
+			}
+			int b=locate(index);
+			blk[b].insert(blk[b].begin()+index,val),total++;
+			if(int(blk[b].size())>2*B){
+				std::vector<int> half(blk[b].begin()+B,blk[b].end());
+				blk[b].resize(B);
+				blk.insert(blk.begin()+b+1,half),blk[b+1].reserve(2*B);
+				rebuild();
+			}
+			else	add(b,1);
 		}
 		inline int lower_bound(int val){
-			int ret=size(),p=root,nowadd=0;
-			while(p){
-				if(tr[p].val>=val)	ret=tr[tr[p].ls].siz+nowadd,p=tr[p].ls;
-				else if(tr[p].val<val)	nowadd+=1+tr[tr[p].ls].siz,p=tr[p].rs;
-				else	p=tr[p].ls;
+			int l=0,r=int(blk.size());
+			while(l<r){
+				int mid=(l+r)>>1;
+				if(blk[mid].back()>=val)	r=mid;
+				else	l=mid+1;
+			}
+			if(l==int(blk.size()))	return total;
+			return prefix(l)+int(std::lower_bound(blk[l].begin(),blk[l].end(),val)-blk[l].begin());
+		}
+	};
+
+
+	/*
+	只支持随机取用和删除的集合，删除时用最后一个元素填补空位，所以各操作都是 O(1) 的，但不保持元素的顺序。
+	适合"从仍然可用的桶中随机选一个"这类不关心顺序的场合。
+	*/
+	class FSwapSet{
+	private:
+		std::vector<int> a;
+	public:
+		inline void clear(){
+			a.clear();
+		}
+		inline void reserve(int n){
+			a.reserve(n);
+		}
+		inline int size() const{
+			return int(a.size());
+		}
+		inline void push_back(int val){
+			a.push_back(val);
+		}
+		int& operator[](int index){
+			return a[index];
+		}
+		inline void erase(int index){
+			a[index]=a.back(),a.pop_back();
+		}
+	};
+
+
+	/*
+	压缩邻接表（CSR）存储的图，点的编号在 [0,n]，用一次计数排序从边的数组建立，O(n+m)。
+	点 x 的出边为 to[fst[x]]~to[fst[x+1]-1]，eid 为对应的边在原数组中的下标，无向图每条边正反各存一次。
+	*/
+	class FGraph{
+	public:
+		int n;
+		std::vector<int> fst,to,eid;
+		FGraph(int n,const std::vector<std::pair<int,int>> &graph,bool directional):n(n),fst(n+2,0){
+			int m=int(graph.size()),M=directional?m:2*m;
+			to.resize(M),eid.resize(M);
+			for(const std::pair<int,int> &it:graph){
+				fst[it.first+1]++;
+				if(!directional)	fst[it.second+1]++;
 			}
+			for(int i=1;i<=n+1;i++)	fst[i]+=fst[i-1];
+			std::vector<int> pos(fst.begin(),fst.end()-1);
+			for(int i=0;i<m;i++){
+				int x=graph[i].first,y=graph[i].second;
+				to[pos[x]]=y,eid[pos[x]++]=i;
+				if(!directional)	to[pos[y]]=x,eid[pos[y]++]=i;
+			}
+		}
+		FGraph():n(0),fst(2,0){}
+		inline int size() const{
+			return n;
+		}
+		inline int edges() const{
+			return int(to.size());
+		}
+		//返回所有边反向后的图，eid 保持不变。
+		inline FGraph transpose() const{
+			FGraph ret;
+			ret.n=n,ret.fst.assign(n+2,0),ret.to.resize(to.size()),ret.eid.resize(eid.size());
+			for(int y:to)	ret.fst[y+1]++;
+			for(int i=1;i<=n+1;i++)	ret.fst[i]+=ret.fst[i-1];
+			std::vector<int> pos(ret.fst.begin(),ret.fst.end()-1);
+			for(int x=0;x<=n;x++)	for(int i=fst[x];i<fst[x+1];i++)
+				ret.to[pos[to[i]]]=x,ret.eid[pos[to[i]]++]=eid[i];
 			return ret;
 		}
 	};
+
+
+	//用 threads 个线程执行 f(0),f(1),...,f(n-1)，每个任务由空闲的线程领取，threads 为 1 时不创建线程。
+	template<typename F> inline void parallel_for(int n,int threads,F f){
+		threads=std::max(1,std::min(threads,n));
+		if(threads==1){
+			for(int i=0;i<n;i++)	f(i);
+			return;
+		}
+		std::atomic<int> cur(0);
+		auto work=[&](){for(int i=cur++;i<n;i=cur++)	f(i);};
+		std::vector<std::thread> pool(0);
+		for(int i=1;i<threads;i++)	pool.emplace_back(work);
+		work();
+		for(std::thread &t:pool)	t.join();
+	}
+
+
+	//用 threads 个线程按 cmp 排序 [first,last)：先分段排序，再逐层两两归并。结果与 std::sort 相同，与线程数无关。
+	template<typename T,typename C> inline void parallel_sort(T first,T last,int threads,C cmp){
+		long long n=last-first;
+		int part=std::max(1,int(std::min<long long>(threads,n/4096)));
+		std::vector<long long> cut(part+1);
+		for(int i=0;i<=part;i++)	cut[i]=n*i/part;
+		parallel_for(part,threads,[&](int i){std::sort(first+cut[i],first+cut[i+1],cmp);});
+		for(int len=1;len<part;len<<=1)
+			parallel_for((part+2*len-1)/(2*len),threads,[&](int i){
+				int l=2*len*i,mid=std::min(l+len,part),r=std::min(l+2*len,part);
+				if(mid<r)	std::inplace_merge(first+cut[l],first+cut[mid],first+cut[r],cmp);
+			});
+	}
+	template<typename T> inline void parallel_sort(T first,T last,int threads){
+		parallel_sort(first,last,threads,std::less<typename std::iterator_traits<T>::value_type>());
+	}
+	//把 [0,k(k-1)/2) 中的编号 c 解码为 {x,y}，0<=x<y<k，c=y(y-1)/2+x。
+	inline std::pair<long long,long long> triangle_pair(long long c){
+		long long y=(long long)((1+sqrtl(1.0L+8.0L*c))/2);
+		while(y*(y-1)/2>c)	y--;
+		while(y*(y+1)/2<=c)	y++;
+		return std::make_pair(c-y*(y-1)/2,y);
+	}
+
+
+	/*
+	存在文件里的边的数组，用内存映射访问，用于边数超过内存的图。
+	支持 size、push_back、resize、下标和指针迭代器，可以直接作为 RandomGraph.graph、RandomScc.scc 等追加边的重载的第一个参数，
+	这时生成边的额外内存只与点数有关（RandomGraph.graph 生成简单图时改为按编号顺序追加边，见它的说明），
+	RandomGraphTool.random_vertices(n,first,last) 会按块打乱编号，RandomPrint.print_sequence_pair(first,last) 可以输出。
+	文件按容量加倍扩大，只追加不移动，内存中只保留正在访问的页，由系统换出。name 为空时使用一个临时文件，析构时删除。
+	Windows 下没有 mmap，退化为存在内存里。
+	*/
+	class FEdgeFile{
+	public:
+		typedef std::pair<int,int> value_type;
+		typedef value_type* iterator;
+		typedef const value_type* const_iterator;
+	private:
+		std::string name;
+		value_type *data;
+		size_t len,cap;
+#ifdef _WIN32
+		std::vector<value_type> mem;
+#else
+		int fd;
+#endif
+		inline void grow(size_t c){
+			if(c<=cap)	return;
+			c=std::max(c,std::max(cap*2,size_t(1<<20)));
+#ifdef _WIN32
+			mem.resize(c),data=mem.data();
+#else
+			if(data)	munmap(data,cap*sizeof(value_type));
+			data=nullptr;
+			if(ftruncate(fd,off_t(c*sizeof(value_type))))	throw std::bad_alloc();
+			void *p=mmap(nullptr,c*sizeof(value_type),PROT_READ|PROT_WRITE,MAP_SHARED,fd,0);
+			if(p==MAP_FAILED)	throw std::bad_alloc();
+			data=(value_type*)p;
+#endif
+			cap=c;
+		}
+		inline void release(){
+#ifdef _WIN32
+			std::vector<value_type>().swap(mem);
+#else
+			if(data)	munmap(data,cap*sizeof(value_type));
+			if(fd>=0){
+				if(ftruncate(fd,off_t(len*sizeof(value_type)))){}
+				close(fd);
+			}
+			fd=-1;
+#endif
+			data=nullptr,len=cap=0;
+		}
+	public:
+		inline explicit FEdgeFile(const std::string &name=""):name(name),data(nullptr),len(0),cap(0){
+#ifndef _WIN32
+			if(name.empty()){
+				const char *dir=getenv("TMPDIR");
+				std::string t=std::string(dir&&*dir?dir:"/tmp")+"/fesdrer_edges_XXXXXX";
+				std::vector<char> path(t.begin(),t.end());
+				path.push_back(0);
+				fd=mkstemp(path.data());
+				if(fd>=0)	unlink(path.data());
+			}
+			else	fd=open(name.c_str(),O_RDWR|O_CREAT|O_TRUNC,0644);
+			assert(fd>=0);
+#endif
+		}
+		FEdgeFile(const FEdgeFile&)=delete;
+		FEdgeFile& operator=(const FEdgeFile&)=delete;
+		//析构时把文件截短到实际的边数，name 不为空时文件保留，内容为 size() 条边，每条边是两个 int。
+		inline ~FEdgeFile(){
+			release();
+		}
+		inline size_t size() const{
+			return len;
+		}
+		inline bool empty() const{
+			return !len;
+		}
+		inline void reserve(size_t n){
+			grow(n);
+		}
+		inline void resize(size_t n){
+			grow(n);
+			for(size_t i=len;i<n;i++)	data[i]=value_type(0,0);
+			len=n;
+		}
+		inline void clear(){
+			len=0;
+		}
+		inline void push_back(const value_type &e){
+			if(len==cap)	grow(len+1);
+			data[len++]=e;
+		}
+		inline value_type& operator[](size_t i){
+			return data[i];
+		}
+		inline const value_type& operator[](size_t i) const{
+			return data[i];
+		}
+		inline value_type& back(){
+			return data[len-1];
+		}
+		inline iterator begin(){
+			return data;
+		}
+		inline iterator end(){
+			return data+len;
+		}
+		inline const_iterator begin() const{
+			return data;
+		}
+		inline const_iterator end() const{
+			return data+len;
+		}
+		inline void swap(FEdgeFile &o){
+			std::swap(name,o.name),std::swap(data,o.data),std::swap(len,o.len),std::swap(cap,o.cap);
+#ifdef _WIN32
+			mem.swap(o.mem);
+#else
+			std::swap(fd,o.fd);
+#endif
+		}
+		/*
+		去掉重边，无向图中 (x,y) 和 (y,x) 算同一条边，每组重边保留一条（方向不变），边的顺序变为按 (min,max) 排序。
+		外部排序：每 run 条边一段在映射上原地排序（threads 个线程），再把各段多路归并到一个新文件，归并时跳过重复的边，
+		任何时候内存中只需要一段的页。
+		*/
+		inline void dedup(bool directional,int threads=1,size_t run=size_t(1)<<25){
+			auto key=[&](const value_type &e){
+				return directional||e.first<=e.second?e:value_type(e.second,e.first);
+			};
+			auto less=[&](const value_type &a,const value_type &b){return key(a)<key(b);};
+			std::vector<size_t> cut(0);
+			for(size_t l=0;l<len;l+=run)	cut.push_back(l);
+			cut.push_back(len);
+			int parts=int(cut.size())-1;
+			for(int i=0;i<parts;i++)	parallel_sort(data+cut[i],data+cut[i+1],threads,less);
+			if(parts<=1){
+				size_t k=0;
+				for(size_t i=0;i<len;i++)	if(!k||key(data[k-1])!=key(data[i]))	data[k++]=data[i];
+				len=k;
+				return;
+			}
+			FEdgeFile out(name.empty()?"":name+".tmp");
+			out.reserve(len);
+			typedef std::pair<value_type,int> item;
+			auto cmp=[&](const item &a,const item &b){return key(b.first)<key(a.first);};
+			std::priority_queue<item,std::vector<item>,decltype(cmp)> q(cmp);
+			std::vector<size_t> at(cut.begin(),cut.end()-1);
+			for(int i=0;i<parts;i++)	q.push(item(data[at[i]++],i));
+			while(!q.empty()){
+				item t=q.top();q.pop();
+				if(out.empty()||key(out.back())!=key(t.first))	out.push_back(t.first);
+				if(at[t.second]<cut[t.second+1])	q.push(item(data[at[t.second]++],t.second));
+			}
+#ifndef _WIN32
+			if(!name.empty())	rename((name+".tmp").c_str(),name.c_str());
+#endif
+			swap(out);
+			std::swap(name,out.name);
+		}
+	};
+
+
+	/*
+	带大缓冲区的输出类，整数用手写的转换输出，缓冲区满或调用 flush() 时用 write 整块写出。
+	可以写到文件描述符（默认是标准输出），也可以通过 redirect() 写到一个 string 里。
+	浮点数的格式与 std::cout 当前的精度和 fixed、scientific 设置一致，showpos、showpoint、uppercase 等其余的格式标志不起作用。
+	定义 FESDRER_USE_ZLIB 或 FESDRER_USE_ZSTD（并链接 -lz 或 -lzstd）后可以用 compress() 把之后的输出压缩成 gzip 或 zstd 格式，
+	缓冲区每次写出时压缩一块，不需要保存整个输出。写出的是标准的 gzip 或 zstd 帧，可以直接用 gzip -d 或 zstd -d 解压，
+	多次 compress() 和 finish() 得到的多个帧首尾相接，解压后就是完整的输出。
+	*/
+	class FWriter{
+	public:
+		enum Compress{NONE,GZIP,ZSTD};
+	private:
+		std::vector<char> buf,zbuf;
+		size_t pos;
+		int fd;
+		std::string *str;
+		Compress zip;
+		void *stream;
+		inline void reserve(size_t n){
+			if(buf.empty())	buf.resize(std::max(size_t(1<<20),n));
+			if(pos+n>buf.size())	flush();
+			if(n>buf.size())	buf.resize(n);
+		}
+		inline void emit(const char *s,size_t n){
+			if(str)	str->append(s,n);
+			else{
+				size_t done=0;
+				while(done<n){
+#ifdef _WIN32
+					int k=_write(fd,s+done,unsigned(n-done));
+#else
+					long long k=::write(fd,s+done,n-done);
+#endif
+					if(k<=0)	break;
+					done+=size_t(k);
+				}
+			}
+		}
+		//压缩 [s,s+n) 并写出，end 为 true 时结束压缩流。
+		inline void deflate_block(const char *s,size_t n,bool end){
+#ifdef FESDRER_USE_ZLIB
+			if(zip==GZIP){
+				z_stream *z=(z_stream*)stream;
+				z->next_in=(Bytef*)s,z->avail_in=uInt(n);
+				int r;
+				do{
+					z->next_out=(Bytef*)zbuf.data(),z->avail_out=uInt(zbuf.size());
+					r=deflate(z,end?Z_FINISH:Z_NO_FLUSH);
+					emit(zbuf.data(),zbuf.size()-z->avail_out);
+				}while(end?r==Z_OK:z->avail_out==0);
+			}
+#endif
+#ifdef FESDRER_USE_ZSTD
+			if(zip==ZSTD){
+				ZSTD_CStream *z=(ZSTD_CStream*)stream;
+				ZSTD_inBuffer in={s,n,0};
+				while(1){
+					ZSTD_outBuffer out={zbuf.data(),zbuf.size(),0};
+					size_t r=end?ZSTD_endStream(z,&out):ZSTD_compressStream(z,&out,&in);
+					emit(zbuf.data(),out.pos);
+					if(ZSTD_isError(r)||(end?r==0:in.pos==in.size))	break;
+				}
+			}
+#endif
+			(void)s,(void)n,(void)end;
+		}
+	public:
+		inline explicit FWriter(int fd=1):pos(0),fd(fd),str(nullptr),zip(NONE),stream(nullptr){}
+		inline ~FWriter(){
+			finish();
+		}
+		//之后的输出写到文件描述符 fd。
+		inline void redirect(int to){
+			finish(),fd=to,str=nullptr;
+		}
+		//之后的输出追加到 s 的末尾。
+		inline void redirect(std::string *s){
+			finish(),str=s;
+		}
+		//之后写到文件描述符的内容不做换行转换。Windows 下文件描述符默认是文本模式，写二进制边块和压缩流之前必须调用，其他平台上什么也不做。
+		inline void binary(){
+			flush();
+#ifdef _WIN32
+			if(!str)	_setmode(fd,_O_BINARY);
+#endif
+		}
+		//交换两个输出对象的全部状态：缓冲区和其中还没写出的内容、输出目标、压缩流。用来临时换一个输出目标而不结束原来的输出。
+		inline void swap(FWriter &o){
+			buf.swap(o.buf),zbuf.swap(o.zbuf);
+			std::swap(pos,o.pos),std::swap(fd,o.fd),std::swap(str,o.str),std::swap(zip,o.zip),std::swap(stream,o.stream);
+		}
+		/*
+		之后的输出压缩成 type 格式，level 为压缩等级（gzip 为 1~9，zstd 为 1~22），直到调用 finish() 或 redirect()。
+		压缩期间不能再和 std::cout、printf 混用。没有定义对应的宏时返回 false，输出不压缩。
+		*/
+		inline bool compress(Compress type,int level=6){
+			finish();
+			if(type!=NONE)	binary();
+#ifdef FESDRER_USE_ZLIB
+			if(type==GZIP){
+				z_stream *z=new z_stream();
+				if(deflateInit2(z,level,Z_DEFLATED,15+16,8,Z_DEFAULT_STRATEGY)!=Z_OK){delete z;return 0;}
+				zip=GZIP,stream=z,zbuf.resize(1<<20);
+				return 1;
+			}
+#endif
+#ifdef FESDRER_USE_ZSTD
+			if(type==ZSTD){
+				ZSTD_CStream *z=ZSTD_createCStream();
+				if(!z||ZSTD_isError(ZSTD_initCStream(z,level))){ZSTD_freeCStream(z);return 0;}
+				zip=ZSTD,stream=z,zbuf.resize(ZSTD_CStreamOutSize());
+				return 1;
+			}
+#endif
+			(void)level;
+			return type==NONE;
+		}
+		//写出缓冲区，压缩时结束压缩流，之后的输出不再压缩。
+		inline void finish(){
+			flush();
+			if(zip==NONE)	return;
+			deflate_block(nullptr,0,1);
+#ifdef FESDRER_USE_ZLIB
+			if(zip==GZIP)	deflateEnd((z_stream*)stream),delete (z_stream*)stream;
+#endif
+#ifdef FESDRER_USE_ZSTD
+			if(zip==ZSTD)	ZSTD_freeCStream((ZSTD_CStream*)stream);
+#endif
+			zip=NONE,stream=nullptr;
+		}
+		inline void flush(){
+			if(!pos)	return;
+			if(zip!=NONE)	deflate_block(buf.data(),pos,0);
+			else	emit(buf.data(),pos);
+			pos=0;
+		}
+		//以小端序写出 x 的低 k 个字节。
+		inline FWriter& put_le(unsigned long long x,int k){
+			reserve(8);
+			for(int i=0;i<k;i++)	buf[pos++]=char(x>>(8*i));
+			return *this;
+		}
+		//写出 x 的 LEB128 变长编码，每个字节存 7 位，小的数只占一个字节。
+		inline FWriter& put_varint(unsigned long long x){
+			reserve(10);
+			while(x>=128)	buf[pos++]=char(x|128),x>>=7;
+			buf[pos++]=char(x);
+			return *this;
+		}
+		inline FWriter& write(const char *s,size_t n){
+			reserve(n);
+			memcpy(buf.data()+pos,s,n),pos+=n;
+			return *this;
+		}
+		inline FWriter& operator<<(char c){
+			reserve(1);
+			buf[pos++]=c;
+			return *this;
+		}
+		inline FWriter& operator<<(bool b){
+			return (*this)<<char('0'+b);
+		}
+		inline FWriter& operator<<(signed char c){
+			return (*this)<<char(c);
+		}
+		inline FWriter& operator<<(unsigned char c){
+			return (*this)<<char(c);
+		}
+		inline FWriter& operator<<(const char *s){
+			return write(s,strlen(s));
+		}
+		inline FWriter& operator<<(const std::string &s){
+			return write(s.data(),s.size());
+		}
+		template<typename T> inline typename std::enable_if<std::is_integral<T>::value&&sizeof(T)!=1,FWriter&>::type operator<<(T x){
+			static const char digits[]=
+				"00010203040506070809101112131415161718192021222324252627282930313233343536373839"
+				"40414243444546474849505152535455565758596061626364656667686970717273747576777879"
+				"8081828384858687888990919293949596979899";
+			reserve(24);
+			unsigned long long u=(unsigned long long)x;
+			if(x<T(0))	buf[pos++]='-',u=0-u;
+			char s[24];
+			int p=24;
+			while(u>=100){
+				int d=int(u%100)*2;
+				u/=100,s[--p]=digits[d+1],s[--p]=digits[d];
+			}
+			if(u>=10)	s[--p]=digits[u*2+1],s[--p]=digits[u*2];
+			else	s[--p]=char('0'+u);
+			memcpy(buf.data()+pos,s+p,24-p),pos+=24-p;
+			return *this;
+		}
+		/*
+		按 std::cout 当前的设置输出浮点数：fixed 用 %f，scientific 用 %e，两个都设置（hexfloat）用 %a，都不设置用 %g，精度取 std::cout.precision()。
+		先求出结果的长度再格式化，std::fixed 下 1e300 这样的数加上很高的精度可以有几百个字符。
+		*/
+		template<typename T> inline FWriter& put_float(T x){
+			std::ios_base::fmtflags f=std::cout.flags()&std::ios_base::floatfield;
+			bool hex=f==(std::ios_base::fixed|std::ios_base::scientific);
+			char fmt[8],*q=fmt;
+			*q++='%';
+			if(!hex)	*q++='.',*q++='*';
+			if(std::is_same<T,long double>::value)	*q++='L';
+			*q++=hex?'a':f==std::ios_base::fixed?'f':f==std::ios_base::scientific?'e':'g';
+			*q=0;
+			int p=int(std::cout.precision());
+			int len=hex?snprintf(nullptr,0,fmt,x):snprintf(nullptr,0,fmt,p,x);
+			if(len<0)	return *this;
+			reserve(size_t(len)+1);
+			if(hex)	snprintf(buf.data()+pos,size_t(len)+1,fmt,x);
+			else	snprintf(buf.data()+pos,size_t(len)+1,fmt,p,x);
+			pos+=size_t(len);
+			return *this;
+		}
+		inline FWriter& operator<<(double x){
+			return put_float(x);
+		}
+		inline FWriter& operator<<(long double x){
+			return put_float(x);
+		}
+		//其余类型通过 operator<<(std::ostream&) 转换。
+		template<typename T> inline typename std::enable_if<!std::is_arithmetic<T>::value&&!std::is_convertible<T,const char*>::value,FWriter&>::type operator<<(const T &x){
+			std::ostringstream s;
+			s<<x;
+			return (*this)<<s.str();
+		}
+	};
+
+
+	/*
+	RandomPrint 输出的二进制边块：4 字节的标记 "\0FEB"（定长）或 "\0FEV"（变长），1 字节的标志（第 0 位表示带权值），然后是边数和每条边。
+	定长：边数占 8 字节，每条边为 4 字节的 x、4 字节的 y，带权值时再加 8 字节的 w，都是小端序。
+	变长：边数为 varint，每条边为 x、y 与上一条边的差的 zigzag varint，带权值时再加 w 的 zigzag varint。
+	块以 \0 开头，文本中不会出现，所以文本和二进制块可以写在同一个文件里。
+	*/
+	inline unsigned long long zigzag(long long x){
+		return ((unsigned long long)x<<1)^(unsigned long long)(x>>63);
+	}
+	inline long long unzigzag(unsigned long long x){
+		return (long long)(x>>1)^-(long long)(x&1);
+	}
+	//把 s 中的文本原样写到 out，二进制边块转成文本，每条边一行，与 RandomPrint.print_graph 的格式相同。格式错误时返回 false。
+	inline bool decode_text(const std::string &s,FWriter &out){
+		const unsigned char *p=(const unsigned char*)s.data(),*end=p+s.size();
+		auto le=[&](int k,unsigned long long &x){
+			if(end-p<k)	return false;
+			x=0;
+			for(int i=0;i<k;i++)	x|=(unsigned long long)p[i]<<(8*i);
+			p+=k;
+			return true;
+		};
+		auto varint=[&](unsigned long long &x){
+			x=0;
+			for(int sh=0;p<end&&sh<64;sh+=7){
+				x|=(unsigned long long)(*p&127)<<sh;
+				if(!(*p++&128))	return true;
+			}
+			return false;
+		};
+		while(p<end){
+			if(*p){
+				const unsigned char *q=(const unsigned char*)memchr(p,0,end-p);
+				if(!q)	q=end;
+				out.write((const char*)p,q-p),p=q;
+				continue;
+			}
+			if(end-p<5||p[1]!='F'||p[2]!='E'||(p[3]!='B'&&p[3]!='V'))	return false;
+			bool fixed=p[3]=='B',weighted=p[4]&1;
+			p+=5;
+			unsigned long long m,x,y,w=0;
+			if(!(fixed?le(8,m):varint(m)))	return false;
+			long long px=0,py=0;
+			for(unsigned long long i=0;i<m;i++){
+				if(fixed){
+					if(!le(4,x)||!le(4,y)||(weighted&&!le(8,w)))	return false;
+					out<<(long long)(int)x<<' '<<(long long)(int)y;
+					if(weighted)	out<<' '<<(long long)w;
+				}
+				else{
+					if(!varint(x)||!varint(y)||(weighted&&!varint(w)))	return false;
+					px+=unzigzag(x),py+=unzigzag(y);
+					out<<px<<' '<<py;
+					if(weighted)	out<<' '<<unzigzag(w);
+				}
+				out<<'\n';
+			}
+		}
+		return true;
+	}
+	/*
+	如果 s 是 gzip 或 zstd 压缩的数据，解压到 out 并返回 true（多段压缩数据首尾相接时依次解压）；不是压缩数据时把 s 复制到 out。
+	需要定义 FESDRER_USE_ZLIB 或 FESDRER_USE_ZSTD 才能解压对应的格式，否则返回 false。
+	*/
+	inline bool decompress(const std::string &s,std::string &out){
+		out.clear();
+		const unsigned char *p=(const unsigned char*)s.data();
+		if(s.size()>=2&&p[0]==0x1f&&p[1]==0x8b){
+#ifdef FESDRER_USE_ZLIB
+			z_stream z;
+			memset(&z,0,sizeof(z));
+			if(inflateInit2(&z,15+16)!=Z_OK)	return false;
+			std::vector<char> buf(1<<20);
+			z.next_in=(Bytef*)s.data(),z.avail_in=uInt(s.size());
+			int r;
+			do{
+				z.next_out=(Bytef*)buf.data(),z.avail_out=uInt(buf.size());
+				r=inflate(&z,Z_NO_FLUSH);
+				out.append(buf.data(),buf.size()-z.avail_out);
+				if(r==Z_STREAM_END&&z.avail_in)	inflateReset(&z),r=Z_OK;
+			}while(r==Z_OK&&(z.avail_in||!z.avail_out));
+			inflateEnd(&z);
+			return r==Z_STREAM_END;
+#else
+			return false;
+#endif
+		}
+		if(s.size()>=4&&p[0]==0x28&&p[1]==0xb5&&p[2]==0x2f&&p[3]==0xfd){
+#ifdef FESDRER_USE_ZSTD
+			ZSTD_DStream *z=ZSTD_createDStream();
+			if(!z||ZSTD_isError(ZSTD_initDStream(z))){ZSTD_freeDStream(z);return false;}
+			std::vector<char> buf(ZSTD_DStreamOutSize());
+			ZSTD_inBuffer in={s.data(),s.size(),0};
+			size_t r=0;
+			while(in.pos<in.size||r){
+				ZSTD_outBuffer o={buf.data(),buf.size(),0};
+				r=ZSTD_decompressStream(z,&o,&in);
+				if(ZSTD_isError(r))	break;
+				out.append(buf.data(),o.pos);
+				if(in.pos==in.size&&o.pos<o.size)	break;
+			}
+			ZSTD_freeDStream(z);
+			return !ZSTD_isError(r)&&r==0;
+#else
+			return false;
+#endif
+		}
+		out=s;
+		return true;
+	}
 }
 
 
 namespace FESDRER_RAND{
 
 
-	static std::mt19937_64 rng_64(std::chrono::steady_clock::now().time_since_epoch().count());
+	/*
+	统计信息。在包含本文件前定义 FESDRER_STATS 后，生成函数会记录随机数的使用次数（draws）、拒绝重试的次数（retries）、
+	哈希表的探测次数（probes）、申请内存的次数和字节数（allocs、bytes），以及生成骨架、加边、打乱编号、输出四个阶段的用时（纳秒）。
+	不定义 FESDRER_STATS 时下面的宏都是空的，生成函数没有任何额外开销，RandomStats 中也不会有数据。
+	*/
+	struct FStats{
+		unsigned long long draws,retries,probes,allocs,bytes;
+		unsigned long long tree,edges,relabel,print;
+	};
+	struct FStatsRecord{
+		std::string name;
+		FStats stats;
+		double seconds;
+	};
+	/*
+	计数器是全局的原子变量，多个线程同时生成时会计到一起。
+	每次调用带统计的函数都会在 log() 中留下一条记录，记录的是这次调用前后计数器的差，所以内层调用的数量也会计入外层调用。
+	*/
+	class RANDOMSTATS{
+	private:
+		std::mutex lock;
+		std::vector<FStatsRecord> records;
+		static inline void print_row(FILE *f,const char *name,const FStats &s,double seconds){
+			fprintf(f,"%-36s %12.6f %14llu %10llu %12llu %10llu %14llu %10.6f %10.6f %10.6f %10.6f\n",name,seconds,s.draws,s.retries,s.probes,s.allocs,s.bytes,
+				s.tree*1e-9,s.edges*1e-9,s.relabel*1e-9,s.print*1e-9);
+		}
+		static inline void print_json(FILE *f,const FStats &s){
+			fprintf(f,"\"draws\": %llu, \"retries\": %llu, \"probes\": %llu, \"allocs\": %llu, \"bytes\": %llu, \"tree_ns\": %llu, \"edges_ns\": %llu, \"relabel_ns\": %llu, \"print_ns\": %llu",
+				s.draws,s.retries,s.probes,s.allocs,s.bytes,s.tree,s.edges,s.relabel,s.print);
+		}
+	public:
+		//计数器没有写构造函数，静态存储的零初始化保证它们在任何构造函数运行前就是 0，全局的 operator new 可以随时使用。
+		std::atomic<unsigned long long> draws,retries,probes,allocs,bytes,tree,edges,relabel,print;
+		//当前所有计数器的值。
+		inline FStats get() const{
+			FStats s;
+			s.draws=draws.load(),s.retries=retries.load(),s.probes=probes.load(),s.allocs=allocs.load(),s.bytes=bytes.load();
+			s.tree=tree.load(),s.edges=edges.load(),s.relabel=relabel.load(),s.print=print.load();
+			return s;
+		}
+		//每次调用的记录。
+		inline std::vector<FStatsRecord> log(){
+			std::lock_guard<std::mutex> guard(lock);
+			return records;
+		}
+		inline void add(const FStatsRecord &r){
+			std::lock_guard<std::mutex> guard(lock);
+			records.push_back(r);
+		}
+		//清空计数器和记录。
+		inline void clear(){
+			std::lock_guard<std::mutex> guard(lock);
+			records.clear();
+			draws=retries=probes=allocs=bytes=tree=edges=relabel=print=0;
+		}
+		//以表格形式输出每次调用的记录和总计，时间的单位是秒。
+		inline void dump(FILE *f=stderr){
+			std::vector<FStatsRecord> now=log();
+			fprintf(f,"%-36s %12s %14s %10s %12s %10s %14s %10s %10s %10s %10s\n","call","seconds","draws","retries","probes","allocs","bytes","tree","edges","relabel","print");
+			for(const FStatsRecord &r:now)	print_row(f,r.name.c_str(),r.stats,r.seconds);
+			print_row(f,"total",get(),0);
+			fflush(f);
+		}
+		//以 JSON 形式输出每次调用的记录和总计。
+		inline void json(FILE *f){
+			std::vector<FStatsRecord> now=log();
+			fprintf(f,"{\n  \"total\": {");
+			print_json(f,get());
+			fprintf(f,"},\n  \"calls\": [\n");
+			for(size_t i=0;i<now.size();i++){
+				fprintf(f,"    {\"name\": \"%s\", \"seconds\": %.9f, ",now[i].name.c_str(),now[i].seconds);
+				print_json(f,now[i].stats);
+				fprintf(f,"}%s\n",i+1<now.size()?",":"");
+			}
+			fprintf(f,"  ]\n}\n");
+			fflush(f);
+		}
+	};
+	/*
+	整个程序共用的一份统计信息。生成函数、下面的宏和替换的 operator new 都通过它访问，所以多个源文件包含本文件时记录的也是同一份。
+	第一次调用时才构造，全局的 operator new 在任何静态对象构造之前就可以使用。
+	*/
+	inline RANDOMSTATS& random_stats(){
+		static RANDOMSTATS s;
+		return s;
+	}
+	//random_stats() 的别名，用来调用 dump()、json() 和 clear()。
+	static RANDOMSTATS &RandomStats=random_stats();
+
+
+	/*
+	一次带统计的调用。构造时记下计数器，析构时把差值写入 random_stats() 的记录。
+	next(p) 结束当前阶段并开始计时阶段 p。调用嵌套时外层的阶段计时会暂停，所以各阶段的总用时不会重复计算。
+	*/
+	class FStatsCall{
+	private:
+		const char *name;
+		FStats start;
+		std::chrono::steady_clock::time_point begin,phase_begin;
+		std::atomic<unsigned long long> *phase;
+		FStatsCall *parent;
+		static inline FStatsCall*& current(){
+			static thread_local FStatsCall *now=nullptr;
+			return now;
+		}
+		inline void pause(){
+			if(phase)	*phase+=(unsigned long long)std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now()-phase_begin).count();
+		}
+		inline void resume(){
+			phase_begin=std::chrono::steady_clock::now();
+		}
+	public:
+		inline explicit FStatsCall(const char *name):name(name),phase(nullptr),parent(current()){
+			if(parent)	parent->pause();
+			current()=this;
+			start=random_stats().get(),begin=std::chrono::steady_clock::now();
+		}
+		inline ~FStatsCall(){
+			pause();
+			FStats end=random_stats().get();
+			FStatsRecord r;
+			r.name=name,r.seconds=std::chrono::duration<double>(std::chrono::steady_clock::now()-begin).count();
+			r.stats.draws=end.draws-start.draws,r.stats.retries=end.retries-start.retries,r.stats.probes=end.probes-start.probes;
+			r.stats.allocs=end.allocs-start.allocs,r.stats.bytes=end.bytes-start.bytes;
+			r.stats.tree=end.tree-start.tree,r.stats.edges=end.edges-start.edges,r.stats.relabel=end.relabel-start.relabel,r.stats.print=end.print-start.print;
+			current()=parent;
+			random_stats().add(r);
+			if(parent)	parent->resume();
+		}
+		inline void next(std::atomic<unsigned long long> &p){
+			pause(),phase=&p,resume();
+		}
+	};
+#ifdef FESDRER_STATS
+#define FESDRER_STAT_ADD(field,k) ((void)FESDRER_RAND::random_stats().field.fetch_add((unsigned long long)(k),std::memory_order_relaxed))
+#define FESDRER_STAT_CALL(name) FESDRER_RAND::FStatsCall fesdrer_stat_call(name)
+#define FESDRER_STAT_PHASE(field) fesdrer_stat_call.next(FESDRER_RAND::random_stats().field)
+#else
+#define FESDRER_STAT_ADD(field,k) ((void)0)
+#define FESDRER_STAT_CALL(name) ((void)0)
+#define FESDRER_STAT_PHASE(field) ((void)0)
+#endif
+
+
+	//SplitMix64，用于把一个 64 位种子扩展成引擎的初始状态。
+	inline unsigned long long splitmix64(unsigned long long &x){
+		unsigned long long z=(x+=0x9e3779b97f4a7c15ull);
+		z=(z^(z>>30))*0xbf58476d1ce4e5b9ull;
+		z=(z^(z>>27))*0x94d049bb133111ebull;
+		return z^(z>>31);
+	}
+
+
+	/*
+	xoshiro256** 随机数引擎，状态 32 字节，周期 2^256-1。
+	jump() 前进 2^128 步，discard(n) 前进 n 步。
+	*/
+	class FXoshiro256{
+	private:
+		unsigned long long s[4];
+		static inline unsigned long long rotl(unsigned long long x,int k){return (x<<k)|(x>>(64-k));}
+		inline unsigned long long step(){
+			unsigned long long ret=rotl(s[1]*5,7)*9,t=s[1]<<17;
+			s[2]^=s[0],s[3]^=s[1],s[1]^=s[2],s[0]^=s[3];
+			s[2]^=t,s[3]=rotl(s[3],45);
+			return ret;
+		}
+	public:
+		typedef unsigned long long result_type;
+		static constexpr result_type min(){return 0;}
+		static constexpr result_type max(){return ~0ull;}
+		inline explicit FXoshiro256(unsigned long long sd=0){
+			seed(sd);
+		}
+		inline void seed(unsigned long long sd){
+			for(int i=0;i<4;i++)	s[i]=splitmix64(sd);
+		}
+		inline result_type operator()(){
+			FESDRER_STAT_ADD(draws,1);
+			return step();
+		}
+		inline void discard(unsigned long long n){
+			while(n--)	step();
+		}
+		inline void jump(){
+			static const unsigned long long J[4]={0x180ec6d33cfd0abaull,0xd5a61266f0c9392cull,0xa9582618e03fc9aaull,0x39abdc4529b1661cull};
+			unsigned long long t[4]={0,0,0,0};
+			for(int i=0;i<4;i++)	for(int b=0;b<64;b++){
+				if(J[i]>>b&1)	for(int j=0;j<4;j++)	t[j]^=s[j];
+				step();
+			}
+			for(int j=0;j<4;j++)	s[j]=t[j];
+		}
+	};
+
+
+	/*
+	PCG64（XSL-RR 128/64）随机数引擎，状态 32 字节，周期 2^128。
+	jump() 前进 2^64 步，discard(n) 通过线性同余的快速幂在 O(log n) 内前进 n 步。
+	*/
+	class FPcg64{
+	private:
+		__uint128_t state,inc;
+		static inline __uint128_t mult(){return ((__uint128_t)0x2360ed051fc65da4ull<<64)|0x4385df649fccf645ull;}
+		inline void advance(__uint128_t delta){
+			__uint128_t cur_mult=mult(),cur_plus=inc,acc_mult=1,acc_plus=0;
+			while(delta){
+				if(delta&1)	acc_mult*=cur_mult,acc_plus=acc_plus*cur_mult+cur_plus;
+				cur_plus=(cur_mult+1)*cur_plus,cur_mult*=cur_mult,delta>>=1;
+			}
+			state=acc_mult*state+acc_plus;
+		}
+	public:
+		typedef unsigned long long result_type;
+		static constexpr result_type min(){return 0;}
+		static constexpr result_type max(){return ~0ull;}
+		inline explicit FPcg64(unsigned long long sd=0){
+			seed(sd);
+		}
+		inline void seed(unsigned long long sd){
+			unsigned long long a=splitmix64(sd),b=splitmix64(sd),c=splitmix64(sd);
+			inc=(((__uint128_t)c<<64|b)<<1)|1,state=0;
+			(*this)(),state+=(__uint128_t)a,(*this)();
+		}
+		inline result_type operator()(){
+			FESDRER_STAT_ADD(draws,1);
+			state=state*mult()+inc;
+			unsigned long long x=(unsigned long long)(state>>64)^(unsigned long long)state;
+			int rot=int(state>>122);
+			return (x>>rot)|(x<<((64-rot)&63));
+		}
+		inline void discard(unsigned long long n){
+			advance(n);
+		}
+		inline void jump(){
+			advance((__uint128_t)1<<64);
+		}
+	};
+
+
+	/*
+	Philox4x32-10 计数器随机数引擎，第 i 个输出只由种子和 i 决定。
+	每个 128 位计数器产生两个 64 位输出，jump() 前进 2^65 步，discard(n) 在 O(1) 内前进 n 步。
+	*/
+	class FPhilox{
+	private:
+		unsigned int key[2],ctr[4],out[4];
+		int idx;
+		inline void generate(){
+			unsigned int c[4]={ctr[0],ctr[1],ctr[2],ctr[3]},k[2]={key[0],key[1]};
+			for(int r=0;r<10;r++){
+				unsigned long long p0=0xd2511f53ull*c[0],p1=0xcd9e8d57ull*c[2];
+				unsigned int n0=(unsigned int)(p1>>32)^c[1]^k[0],n2=(unsigned int)(p0>>32)^c[3]^k[1];
+				c[0]=n0,c[1]=(unsigned int)p1,c[2]=n2,c[3]=(unsigned int)p0;
+				k[0]+=0x9e3779b9u,k[1]+=0xbb67ae85u;
+			}
+			for(int i=0;i<4;i++)	out[i]=c[i];
+		}
+		inline void add_counter(unsigned long long lo,unsigned long long hi){
+			unsigned long long a=((unsigned long long)ctr[1]<<32|ctr[0]),b=((unsigned long long)ctr[3]<<32|ctr[2]);
+			b+=hi+(a+lo<a),a+=lo;
+			ctr[0]=(unsigned int)a,ctr[1]=(unsigned int)(a>>32),ctr[2]=(unsigned int)b,ctr[3]=(unsigned int)(b>>32);
+		}
+	public:
+		typedef unsigned long long result_type;
+		static constexpr result_type min(){return 0;}
+		static constexpr result_type max(){return ~0ull;}
+		inline explicit FPhilox(unsigned long long sd=0){
+			seed(sd);
+		}
+		inline void seed(unsigned long long sd){
+			key[0]=(unsigned int)sd,key[1]=(unsigned int)(sd>>32);
+			ctr[0]=ctr[1]=ctr[2]=ctr[3]=0,idx=0;
+			generate();
+		}
+		inline result_type operator()(){
+			FESDRER_STAT_ADD(draws,1);
+			if(idx==2)	add_counter(1,0),generate(),idx=0;
+			idx++;
+			return (unsigned long long)out[2*idx-1]<<32|out[2*idx-2];
+		}
+		inline void discard(unsigned long long n){
+			int rest=int(n&1)+idx;
+			add_counter((n>>1)+(rest>>1),0),idx=rest&1;
+			generate();
+		}
+		inline void jump(){
+			add_counter(0,1),generate();
+		}
+	};
+
+
+	/*
+	当前使用的随机数引擎，在包含本文件前定义以下宏之一来选择：
+	FESDRER_ENGINE_PCG64 使用 FPcg64，FESDRER_ENGINE_PHILOX 使用 FPhilox，默认使用 FXoshiro256。
+	所有随机函数都从 rng_64 中取随机数，每个线程各有一个 rng_64。
+	*/
+#if defined(FESDRER_ENGINE_PCG64)
+	typedef FPcg64 FEngine;
+#elif defined(FESDRER_ENGINE_PHILOX)
+	typedef FPhilox FEngine;
+#else
+	typedef FXoshiro256 FEngine;
+#endif
+
+
+	//默认种子，由当前时间和线程编号混合而成。
+	inline unsigned long long random_default_seed(){
+		return (unsigned long long)std::chrono::steady_clock::now().time_since_epoch().count()^((unsigned long long)std::hash<std::thread::id>()(std::this_thread::get_id())<<1);
+	}
+
+
+	static thread_local FEngine rng_64(random_default_seed());
+
+
+	/*
+	从 base 开始依次 jump()，返回 k 个互不重叠的子随机数流，base 会前进到最后一个子流之后。
+	并行生成时每个数据块固定使用一个子流，因此结果只与种子有关，与线程数无关。
+	*/
+	inline std::vector<FEngine> random_substreams(FEngine &base,int k){
+		std::vector<FEngine> ret(0);
+		for(int i=0;i<k;i++)	base.jump(),ret.push_back(base);
+		return ret;
+	}
+
+
+	//设置当前线程的随机种子，相同的种子会生成相同的数据。
+	inline void random_seed(unsigned long long sd){
+		rng_64.seed(sd);
+	}
+
+
+	/*
+	在 [0,s) 中均匀随机生成一个整数，s 为 0 表示 [0,2^64)。
+	使用 Lemire 的乘法移位方法，只有极少数情况需要取模和重新生成。
+	*/
+	template<typename G> inline unsigned long long random_bounded(unsigned long long s,G &g){
+		unsigned long long x=g();
+		if(!s)	return x;
+		__uint128_t m=(__uint128_t)x*s;
+		unsigned long long lo=(unsigned long long)m;
+		if(lo<s){
+			unsigned long long t=(0-s)%s;
+			while(lo<t)	x=g(),m=(__uint128_t)x*s,lo=(unsigned long long)m,FESDRER_STAT_ADD(retries,1);
+		}
+		return (unsigned long long)(m>>64);
+	}
+	inline unsigned long long random_bounded(unsigned long long s){
+		return random_bounded(s,rng_64);
+	}
 
 
 	/*
@@ -144,11 +1165,11 @@ namespace FESDRER_RAND{
 	*/
 	inline long long random(long long l,long long r,double opt=1){
 		if(fabs(opt-1)>1e-8){
-			double it=std::uniform_int_distribution<long long>(1,10000)(rng_64);
+			double it=random_bounded(10000)+1;
 			it/=10000.0,it=pow((1-pow(1-it,opt)),1.0/opt);
 			return (r-l)*it+l;
 		}
-		return std::uniform_int_distribution<long long>(l,r)(rng_64);
+		return (long long)((unsigned long long)l+random_bounded((unsigned long long)r-(unsigned long long)l+1));
 	}
 
 
@@ -166,8 +1187,121 @@ namespace FESDRER_RAND{
 	}
 
 
+	/*
+	批量随机整数采样器，每次生成的整数与 random(l,r,opt) 同分布。
+	区间的取模阈值和 opt 的偏移变换（即 random() 中的两次 pow）都在构造时预处理一次，之后每次生成只需要一次乘法和一次查表。
+	偏移变换的表只与 opt 有关，按 opt 缓存，同一个 opt 只计算一次，所以在循环里反复构造采样器也很便宜。
+	*/
+	class FSampler{
+	private:
+		long long l,r;
+		unsigned long long s,t;
+		std::vector<double> own;
+		const std::vector<double> *skew;
+		//opt 对应的表。表存在 std::map 的节点里，地址不会改变；不同的 opt 太多时不再缓存，由调用者自己保存。
+		static inline const std::vector<double>* table(double opt,std::vector<double> &own){
+			static std::mutex lock;
+			static std::map<double,std::vector<double>> cache;
+			auto make=[&](std::vector<double> &v){
+				v.resize(10000);
+				for(int i=0;i<10000;i++)	v[i]=pow((1-pow(1-(i+1)/10000.0,opt)),1.0/opt);
+			};
+			std::lock_guard<std::mutex> guard(lock);
+			std::map<double,std::vector<double>>::iterator it=cache.find(opt);
+			if(it!=cache.end())	return &it->second;
+			if(cache.size()>=64)	return make(own),&own;
+			make(cache[opt]);
+			return &cache[opt];
+		}
+	public:
+		inline FSampler(long long l=0,long long r=0,double opt=1):l(l),r(r),skew(nullptr){
+			s=(unsigned long long)r-(unsigned long long)l+1,t=(s?(0-s)%s:0);
+			if(fabs(opt-1)>1e-8)	skew=table(opt,own);
+		}
+		inline FSampler(const FSampler &o):l(o.l),r(o.r),s(o.s),t(o.t),own(o.own),skew(o.skew==&o.own?&own:o.skew){}
+		inline FSampler& operator=(const FSampler &o){
+			l=o.l,r=o.r,s=o.s,t=o.t,own=o.own,skew=(o.skew==&o.own?&own:o.skew);
+			return *this;
+		}
+		//用引擎 g 生成 [l,r] 中的一个随机整数，不同线程可以用各自的引擎共用一个采样器。
+		template<typename G> inline long long operator()(G &g) const{
+			if(skew)	return (r-l)*(*skew)[random_bounded(10000,g)]+l;
+			unsigned long long x=g();
+			if(!s)	return (long long)x;
+			__uint128_t m=(__uint128_t)x*s;
+			while((unsigned long long)m<t)	x=g(),m=(__uint128_t)x*s,FESDRER_STAT_ADD(retries,1);
+			return (long long)((unsigned long long)l+(unsigned long long)(m>>64));
+		}
+		//生成 [l,r] 中的一个随机整数。
+		inline long long operator()() const{
+			return (*this)(rng_64);
+		}
+		//生成 [L,R] 中的一个随机整数，沿用构造时的 opt。
+		inline long long operator()(long long L,long long R) const{
+			if(skew)	return (R-L)*(*skew)[random_bounded(10000)]+L;
+			return (long long)((unsigned long long)L+random_bounded((unsigned long long)R-(unsigned long long)L+1));
+		}
+	};
+
+
 	//基本随机函数
 	class RANDOMBASIC{
+	private:
+		//用 g 填满 [first,last)：16 位的 x 映射为 x*k>>16，低 16 位小于 2^16 mod k 时丢弃（Lemire 的方法），保证均匀。总是写入，接受时才前进。
+		template<typename G> static inline void fill_chars(char* first,char* last,const char* charset,unsigned k,G &g){
+			const unsigned t=65536u%k;
+			char* p=first;
+			while(last-p>=4){
+				unsigned long long x=g();
+				for(int j=0;j<4;j++,x>>=16){
+					unsigned m=unsigned(x&65535)*k;
+					*p=charset[m>>16],p+=(m&65535)>=t;
+				}
+			}
+			while(p!=last){
+				unsigned m=unsigned(g()&65535)*k;
+				if((m&65535)>=t)	*p++=charset[m>>16];
+			}
+		}
+		static inline unsigned long long mulmod(unsigned long long x,unsigned long long y,unsigned long long mod){
+			return mod?(unsigned long long)((__uint128_t)x*y%mod):x*y;
+		}
+		static inline unsigned long long addmod(unsigned long long x,unsigned long long y,unsigned long long mod){
+			if(!mod)	return x+y;
+			y%=mod;
+			return x>=mod-y?x-(mod-y):x+y;
+		}
+		/*
+		树攻击：找不全为 0 的 c[j]∈{-1,0,1}，使 sum c[j]*M*P^(n-1-j) 模 mod 为 0，n=2^k，找不到时返回空数组。
+		每一层把值排序后相邻两个相减（大的取 +1，小的取 -1），值大约减少 log(个数) 位，出现 0 时沿着树把符号传回叶子。
+		*/
+		static inline std::vector<int> tree_attack(unsigned long long M,unsigned long long P,unsigned long long mod,int k){
+			int n=1<<k;
+			std::vector<std::vector<unsigned long long>> val(k+1);
+			std::vector<std::vector<std::pair<int,int>>> son(k+1);
+			val[0].resize(n);
+			for(int j=n-1;j>=0;j--)	val[0][j]=M,M=mulmod(M,P,mod);
+			std::vector<int> c(0);
+			std::function<void(int,int,int)> put=[&](int l,int x,int sg){
+				if(!l)	c[x]=sg;
+				else	put(l-1,son[l][x].first,sg),put(l-1,son[l][x].second,-sg);
+			};
+			for(int l=0;l<=k;l++){
+				for(int x=0;x<int(val[l].size());x++)	if(!val[l][x]){
+					c.assign(n,0),put(l,x,1);
+					return c;
+				}
+				if(l==k)	break;
+				std::vector<int> id(val[l].size());
+				for(int i=0;i<int(id.size());i++)	id[i]=i;
+				std::sort(id.begin(),id.end(),[&](int x,int y){return val[l][x]<val[l][y];});
+				for(int i=0;i+1<int(id.size());i+=2){
+					val[l+1].push_back(val[l][id[i+1]]-val[l][id[i]]);
+					son[l+1].push_back({id[i+1],id[i]});
+				}
+			}
+			return c;
+		}
 	public:
 		//随机打乱数组。
 		template<typename T> inline void random_shuffle(T first,T last){
@@ -177,14 +1311,20 @@ namespace FESDRER_RAND{
 				if(i!=j)	std::iter_swap(i,j);
 			}
 		}
-		//随机生成一个数组。
-		template<typename T> inline std::vector<T> random_sequence(int n,T l,T r){
-			std::vector<T> ret;ret.clear();
-			while(n--)	ret.push_back(random(l,r));
+		//随机生成一个数组，opt 的含义与 random() 相同。
+		template<typename T> inline std::vector<T> random_sequence(int n,T l,T r,double opt=1){
+			std::vector<T> ret(std::max(n,0));
+			random_sequence(ret.begin(),ret.end(),l,r,opt);
 			return ret;
 		}
-		template<typename T,typename V> inline void random_sequence(T first,T last,V l,V r){
-			for(T i=first;i!=last;i++)	(*i)=random(l,r);
+		template<typename T,typename V> inline void random_sequence(T first,T last,V l,V r,double opt=1){
+			FSampler R(l,r,opt);
+			for(T i=first;i!=last;i++)	(*i)=R();
+		}
+		//随机生成一个数组，第 i 个元素在 [lfirst[i],rfirst[i]] 中，opt 的含义与 random() 相同。
+		template<typename T,typename L,typename R> inline void random_sequence_each(T first,T last,L lfirst,R rfirst,double opt=1){
+			FSampler S(0,0,opt);
+			for(T i=first;i!=last;i++,lfirst++,rfirst++)	(*i)=S(*lfirst,*rfirst);
 		}
 		//随机生成一个排列。
 		inline std::vector<int> random_permutation(int n){
@@ -198,77 +1338,460 @@ namespace FESDRER_RAND{
 			for(T i=first;i!=last;i++)	(*i)=++p;
 			random_shuffle(first,last);
 		}
-		//随机返回一个字符串，字符集是 charset
-		inline std::string random_string(int n,const char* charset="abcdefghijklmnopqrstuvwxyz"){
-			std::string ret="";
-			int leng=strlen(charset);
-			for(int i=0;i<n;i++)	ret+=charset[random(0,leng-1)];
+		/*
+		随机返回一个字符串，字符集是 charset。threads 为生成时使用的线程数。
+		每个 64 位随机数切成 4 段 16 位，用乘法映射到字符集的下标，不需要取模，也没有分支。
+		长度超过 2^20 时按固定大小分块，每块使用固定的子随机数流，因此种子相同时结果与线程数无关。
+		*/
+		inline std::string random_string(int n,const char* charset="abcdefghijklmnopqrstuvwxyz",int threads=1){
+			if(n<=0)	return "";
+			std::string ret(n,' ');
+			random_string(&ret[0],&ret[0]+n,charset,threads);
+			return ret;
+		}
+		inline void random_string(char* first,char* last,const char* charset="abcdefghijklmnopqrstuvwxyz",int threads=1){
+			unsigned k=unsigned(strlen(charset));
+			assert(k>0);
+			if(k>65536){
+				FSampler R(0,int(k)-1);
+				for(char* i=first;i!=last;i++)	(*i)=charset[R()];
+				return;
+			}
+			const long long block=1<<20;
+			long long n=last-first;
+			if(n<=block)	return fill_chars(first,last,charset,k,rng_64);
+			FEngine base(rng_64());
+			int chunk=int((n+block-1)/block);
+			std::vector<FEngine> eng=random_substreams(base,chunk);
+			FESDRER_STL::parallel_for(chunk,threads,[&](int c){
+				fill_chars(first+c*block,first+std::min(n,(c+1)*block),charset,k,eng[c]);
+			});
+		}
+		//随机生成一个长为 p 的串，重复到长度 n，再随机选 noise 次位置（可能重复）改成随机的字符（可能不变）。
+		inline std::string random_periodic_string(int n,int p,const char* charset="abcdefghijklmnopqrstuvwxyz",int noise=0){
+			assert(p>=1);
+			if(n<=0)	return "";
+			std::string ret(n,' ');
+			random_string(&ret[0],&ret[0]+std::min(n,p),charset);
+			for(long long len=p;len<n;len*=2)	memcpy(&ret[len],&ret[0],std::min<long long>(len,n-len));
+			FSampler R(0,int(strlen(charset))-1);
+			for(int i=0;i<noise;i++)	ret[random_bounded(n)]=charset[R()];
 			return ret;
 		}
-		inline void random_string(char* first,char* last,const char* charset="abcdefghijklmnopqrstuvwxyz"){
-			int leng=strlen(charset);
-			for(char* i=first;i!=last;i++)	(*i)=charset[random(0,leng-1)];
+		//长为 n 的 Fibonacci 串 abaababaabaab... 的前缀。f(k+1)=f(k)f(k-1)，f(k-1) 是已有部分的前缀，所以原地倍增即可。
+		inline std::string fibonacci_string(int n,char a='a',char b='b'){
+			std::string ret(std::max(n,0),a);
+			if(n<2)	return ret;
+			ret[1]=b;
+			for(long long pre=1,len=2;len<n;){
+				memcpy(&ret[len],&ret[0],std::min<long long>(pre,n-len));
+				len+=pre,pre=len-pre;
+			}
+			return ret;
+		}
+		//长为 n 的 Thue-Morse 串 abbabaab... 的前缀，第 i 个字符由 i 的二进制中 1 的个数的奇偶性决定。
+		inline std::string thue_morse_string(int n,char a='a',char b='b'){
+			std::string ret(std::max(n,0),a);
+			for(int i=0;i<n;i++)	ret[i]=__builtin_parity(i)?b:a;
+			return ret;
+		}
+		/*
+		随机生成一个长为 n（偶数）的合法括号序列，所有合法括号序列等概率。brackets 为若干对括号，如 "()[]{}"，每一对括号的种类也随机。
+		先随机排列 n/2 个左括号和 n/2+1 个右括号，由循环引理恰好有一个循环移位使得除最后一个字符外每个前缀都合法，
+		即从前缀和第一次取到最小值的位置之后开始，去掉最后的右括号就是结果。
+		*/
+		inline std::string random_bracket_string(int n,const char* brackets="()"){
+			int k=int(strlen(brackets))/2;
+			assert(n>=0&&n%2==0&&k>=1);
+			std::string s(n+1,')'),ret;
+			long long open=n/2,sum=0,low=0,start=0;
+			for(int i=0;i<=n;i++){
+				if((long long)random_bounded(n+1-i)<open)	s[i]='(',open--,sum++;
+				else	sum--;
+				if(sum<low)	low=sum,start=i+1;
+			}
+			ret.reserve(n);
+			ret.append(s,start,n+1-start).append(s,0,start-1);
+			std::vector<char> close(0);
+			for(char &c:ret){
+				if(c=='('){
+					int t=k>1?int(random_bounded(k)):0;
+					c=brackets[2*t],close.push_back(brackets[2*t+1]);
+				}
+				else	c=close.back(),close.pop_back();
+			}
+			return ret;
+		}
+		//由长为 len 的随机回文串依次拼成的长为 n 的字符串，最后一段可能较短，也是回文串。
+		inline std::string random_palindrome_string(int n,int len,const char* charset="abcdefghijklmnopqrstuvwxyz"){
+			assert(len>=1);
+			if(n<=0)	return "";
+			std::string ret=random_string(n,charset);
+			for(int st=0;st<n;st+=len)
+				for(int i=st,j=std::min(n,st+len)-1;i<j;i++,j--)	ret[j]=ret[i];
+			return ret;
+		}
+		/*
+		生成两个长度相同的不同的字符串，在 hashes 中的每一组 {base,mod} 下多项式哈希值都相同，
+		哈希值为 s[0]*base^(n-1)+s[1]*base^(n-2)+...+s[n-1] 模 mod，mod 为 0 表示对 2^64 取模（unsigned long long 自然溢出）。
+		两个串只由字符 a 和 a+1 组成，哈希值的差只与对应位置的差有关，所以把字符整体平移（如 s[i]-'a'+1）后哈希值仍然相同。
+		对每一组依次用树攻击：把上一步的两个串 A、B 当作两个字母，拼出对这一组也相同的两个串，长度为上一步的至多 2^k 倍。
+		一个约 30 位的模数时长度约为 2^10，两个时约为 10^6。
+		*/
+		inline std::pair<std::string,std::string> hash_collision(const std::vector<std::pair<unsigned long long,unsigned long long>> &hashes,char a='a'){
+			std::string A(1,a),B(1,char(a+1));
+			for(const std::pair<unsigned long long,unsigned long long> &h:hashes){
+				unsigned long long base=h.first,mod=h.second,HA=0,HB=0,P=1;
+				if(mod)	base%=mod;
+				for(size_t i=0;i<A.size();i++){
+					HA=addmod(mulmod(HA,base,mod),(unsigned char)A[i],mod);
+					HB=addmod(mulmod(HB,base,mod),(unsigned char)B[i],mod);
+					P=mulmod(P,base,mod);
+				}
+				unsigned long long M=addmod(HA,mod?mod-HB%mod:0-HB,mod);
+				if(!M)	continue;
+				std::vector<int> c(0);
+				for(int k=1;c.empty();k++){
+					assert(k<=24);
+					c=tree_attack(M,P,mod,k);
+				}
+				size_t j=0;
+				while(!c[j])	j++;
+				std::string X,Y;
+				X.reserve((c.size()-j)*A.size()),Y.reserve((c.size()-j)*A.size());
+				for(;j<c.size();j++)	X+=c[j]<0?B:A,Y+=c[j]>0?B:A;
+				A.swap(X),B.swap(Y);
+			}
+			return std::make_pair(A,B);
 		}
 	};
 	static RANDOMBASIC RandomBasic;
 
 
-	//输出辅助函数。
+	/*
+	不重复抽样函数：从 [0,U) 中除去 ex 的数里随机选出 k 个不同的数，以随机顺序返回。
+	根据 k 和可选数的个数 V 选择做法：
+	V<=10k 时用 Vitter 的顺序抽样；k 很小时用 Floyd 算法；V 不太大时用位图拒绝采样；否则分块并行生成候选数，排序去重后补足。
+	*/
+	class RANDOMDISTINCT{
+	private:
+		template<typename T> inline void shuffle(std::vector<T> &a,FEngine &g){
+			for(long long i=1;i<(long long)a.size();i++)	std::swap(a[i],a[random_bounded(i+1,g)]);
+		}
+		static inline double unit(FEngine &g){
+			return ((g()>>11)+0.5)*(1.0/9007199254740992.0);
+		}
+		/*
+		Vitter 的 D 算法：从 [0,N) 中按从小到大的顺序选出 n 个数，每选出一个调用一次 f(x)。
+		每次直接生成两个被选数之间跳过的个数，期望 O(n) 时间，O(1) 额外空间。剩余部分较稠密时转为 A 算法。
+		*/
+		template<typename F> inline void vitter(long long N,long long n,FEngine &g,F f){
+			long long cur=0;
+			const double alpha_inverse=13;
+			double threshold=alpha_inverse*n,vprime=exp(log(unit(g))/n),qu1=double(N-n+1);
+			while(n>1&&threshold<N){
+				double nmin1inv=1.0/(n-1),X,S;
+				while(true){
+					while(true){
+						X=N*(1-vprime),S=floor(X);
+						if(S<qu1)	break;
+						vprime=exp(log(unit(g))/n);
+					}
+					double y1=exp(log(unit(g)*N/qu1)*nmin1inv);
+					vprime=y1*(1-X/N)*(qu1/(qu1-S));
+					if(vprime<=1)	break;
+					double y2=1,top=N-1,bottom,limit;
+					if(n-1>S)	bottom=double(N-n),limit=double(N-S);
+					else	bottom=N-S-1,limit=qu1;
+					for(double t=N-1;t>=limit;t--)	y2=(y2*top)/bottom,top--,bottom--;
+					if(N/(N-X)>=y1*exp(log(y2)*nmin1inv)){
+						vprime=exp(log(unit(g))*nmin1inv);
+						break;
+					}
+					vprime=exp(log(unit(g))/n);
+				}
+				long long s=(long long)S;
+				f(cur+s),cur+=s+1;
+				N-=s+1,n--,qu1-=S,threshold-=alpha_inverse;
+			}
+			if(n==1&&N>0){
+				long long s=std::min(N-1,(long long)(N*vprime));
+				f(cur+s);
+				return;
+			}
+			double top=double(N-n),Nreal=double(N);
+			while(n>=2){
+				double V=unit(g),quot=top/Nreal;
+				long long s=0;
+				while(quot>V)	s++,top--,Nreal--,quot=(quot*top)/Nreal;
+				f(cur+s),cur+=s+1,Nreal--,n--;
+			}
+			if(n==1)	f(cur+(long long)random_bounded((unsigned long long)Nreal,g));
+		}
+		inline std::vector<long long> sequential(long long V,long long k,FEngine &g){
+			std::vector<long long> ret(0);
+			ret.reserve(k);
+			vitter(V,k,g,[&](long long x){ret.push_back(x);});
+			shuffle(ret,g);
+			return ret;
+		}
+		inline std::vector<long long> floyd(long long V,long long k,FEngine &g){
+			int siz=4;
+			while(siz<2*k)	siz<<=1;
+			std::vector<long long> tab(siz,-1),ret(0);
+			auto Insert=[&](long long x){
+				int p=int((unsigned long long)x*0x9e3779b97f4a7c15ull>>40)&(siz-1);
+				while(tab[p]!=-1){
+					FESDRER_STAT_ADD(probes,1);
+					if(tab[p]==x)	return false;
+					p=(p+1)&(siz-1);
+				}
+				tab[p]=x;
+				return true;
+			};
+			for(long long j=V-k;j<V;j++){
+				long long t=random_bounded(j+1,g);
+				if(Insert(t))	ret.push_back(t);
+				else	Insert(j),ret.push_back(j);
+			}
+			shuffle(ret,g);
+			return ret;
+		}
+		inline std::vector<long long> bitmap(long long V,long long k,FEngine &g){
+			std::vector<unsigned long long> bit((V+63)/64,0);
+			std::vector<long long> ret(0);
+			while((long long)ret.size()<k){
+				long long x=random_bounded(V,g);
+				if(bit[x>>6]>>(x&63)&1){
+					FESDRER_STAT_ADD(retries,1);
+					continue;
+				}
+				bit[x>>6]|=1ull<<(x&63),ret.push_back(x);
+			}
+			return ret;
+		}
+		inline std::vector<long long> batch(long long V,long long k,FEngine &g,int threads){
+			const int block=1<<16;
+			std::vector<long long> ret(0);
+			while((long long)ret.size()<k){
+				long long need=k-(long long)ret.size(),cnt=need+need/16+16;
+				int chunk=int((cnt+block-1)/block);
+				std::vector<FEngine> eng=random_substreams(g,chunk);
+				std::vector<long long> cand(cnt),now(0);
+				FESDRER_STL::parallel_for(chunk,threads,[&](int c){
+					for(long long i=1ll*c*block;i<std::min(cnt,1ll*(c+1)*block);i++)	cand[i]=random_bounded(V,eng[c]);
+				});
+				FESDRER_STL::parallel_sort(cand.begin(),cand.end(),threads);
+				cand.erase(std::unique(cand.begin(),cand.end()),cand.end());
+				std::set_difference(cand.begin(),cand.end(),ret.begin(),ret.end(),std::back_inserter(now));
+				FESDRER_STAT_ADD(retries,cnt-(long long)now.size());
+				long long mid=(long long)ret.size();
+				ret.insert(ret.end(),now.begin(),now.end());
+				std::inplace_merge(ret.begin(),ret.begin()+mid,ret.end());
+			}
+			shuffle(ret,g);
+			ret.resize(k);
+			return ret;
+		}
+	public:
+		//从 [0,U) 中除去 ex 的数里随机选出 k 个不同的数，以随机顺序返回。threads 为分块并行时使用的线程数，结果与线程数无关。
+		inline std::vector<long long> sample(long long U,long long k,std::vector<long long> ex=std::vector<long long>(0),int threads=1){
+			FESDRER_STAT_CALL("RandomDistinct.sample");
+			sort(ex.begin(),ex.end());
+			ex.erase(std::unique(ex.begin(),ex.end()),ex.end());
+			while(!ex.empty()&&ex.back()>=U)	ex.pop_back();
+			long long V=U-(long long)ex.size();
+			assert(k>=0&&k<=V);
+			if(k==0)	return std::vector<long long>(0);
+			FEngine g(rng_64());
+			std::vector<long long> ret;
+			if(V/k<=10)	ret=sequential(V,k,g);
+			else if(k<=2048)	ret=floyd(V,k,g);
+			else if(V/k<=128)	ret=bitmap(V,k,g);
+			else	ret=batch(V,k,g,threads);
+			if(!ex.empty()){
+				for(int i=0;i<int(ex.size());i++)	ex[i]-=i;
+				for(long long &x:ret)	x+=std::upper_bound(ex.begin(),ex.end(),x)-ex.begin();
+			}
+			return ret;
+		}
+		/*
+		从 [0,U) 中除去 ex 的数里随机选出 k 个不同的数，按从小到大的顺序每选出一个就调用一次 f(x)。
+		不保存选出的数，除 ex 外只用 O(1) 的额外空间，适合边选边输出。
+		*/
+		template<typename F> inline void sample_sorted(long long U,long long k,F f,std::vector<long long> ex=std::vector<long long>(0)){
+			FESDRER_STAT_CALL("RandomDistinct.sample_sorted");
+			sort(ex.begin(),ex.end());
+			ex.erase(std::unique(ex.begin(),ex.end()),ex.end());
+			while(!ex.empty()&&ex.back()>=U)	ex.pop_back();
+			long long V=U-(long long)ex.size();
+			assert(k>=0&&k<=V);
+			if(k==0)	return;
+			FEngine g(rng_64());
+			size_t p=0;
+			vitter(V,k,g,[&](long long x){
+				while(p<ex.size()&&ex[p]-(long long)p<=x)	p++;
+				f(x+(long long)p);
+			});
+		}
+		//返回 ids 中每个值第一次出现的下标（从小到大），按原顺序去重时只需保留这些下标。
+		inline std::vector<int> first_occurrence(const std::vector<long long> &ids,int threads=1){
+			std::vector<std::pair<long long,int>> a(ids.size());
+			for(int i=0;i<int(ids.size());i++)	a[i]={ids[i],i};
+			FESDRER_STL::parallel_sort(a.begin(),a.end(),threads);
+			std::vector<int> ret(0);
+			for(int i=0;i<int(a.size());i++)	if(!i||a[i].first!=a[i-1].first)	ret.push_back(a[i].second);
+			sort(ret.begin(),ret.end());
+			return ret;
+		}
+	};
+	static RANDOMDISTINCT RandomDistinct;
+
+
+	//RandomPrint 使用的输出缓冲区，每个线程一个，写到标准输出。
+	static thread_local FESDRER_STL::FWriter fout;
+
+
+	/*
+	输出辅助函数。
+	所有输出先写入 fout 的缓冲区再整块写出。每次输出前会先刷新 std::cout 和 stdout，输出完立即写出，因此可以和 std::cout、printf 混用。
+	*/
 	class RANDOMPRINT{
+	private:
+		inline FESDRER_STL::FWriter& begin(){
+			std::cout.flush(),fflush(stdout);
+			return fout;
+		}
+		//输出一个二进制边块，edge(i) 为第 i 条边，weight(i) 为它的权值。
+		template<typename E,typename W> inline void edge_block(size_t m,bool varint,bool weighted,E edge,W weight){
+			FESDRER_STL::FWriter &out=begin();
+			out.binary();
+			out.write(varint?"\0FEV":"\0FEB",4)<<char(weighted);
+			if(varint)	out.put_varint(m);
+			else	out.put_le(m,8);
+			long long px=0,py=0;
+			for(size_t i=0;i<m;i++){
+				std::pair<int,int> e=edge(i);
+				if(varint){
+					out.put_varint(FESDRER_STL::zigzag(e.first-px)).put_varint(FESDRER_STL::zigzag(e.second-py));
+					if(weighted)	out.put_varint(FESDRER_STL::zigzag(weight(i)));
+					px=e.first,py=e.second;
+				}
+				else{
+					out.put_le((unsigned int)e.first,4).put_le((unsigned int)e.second,4);
+					if(weighted)	out.put_le((unsigned long long)weight(i),8);
+				}
+			}
+			out.flush();
+		}
 	public:
 		//输出数组，输出一行。
 		template<typename T> inline void print_sequence(T first,T second){
-			for(T it=first;it!=second;it++)	std::cout<<(*it)<<" ";
-			std::cout<<'\n';
+			FESDRER_STAT_CALL("RandomPrint.print_sequence");FESDRER_STAT_PHASE(print);
+			FESDRER_STL::FWriter &out=begin();
+			for(T it=first;it!=second;it++)	out<<(*it)<<' ';
+			out<<'\n';
+			out.flush();
 		}
 		//输出数组，输出一行。
-		template<typename T> inline void print_sequence(std::vector<T> s){
-			for(T i:s)	std::cout<<i<<" ";
-			std::cout<<'\n';
+		template<typename T> inline void print_sequence(const std::vector<T> &s){
+			print_sequence(s.begin(),s.end());
 		}
 		//输出由二元组组成的数组，每个二元组一行。
 		template<typename T> inline void print_sequence_pair(T first,T second){
-			for(T it=first;it!=second;it++)	std::cout<<(*it).first<<" "<<(*it).second<<'\n';
+			FESDRER_STAT_CALL("RandomPrint.print_sequence_pair");FESDRER_STAT_PHASE(print);
+			FESDRER_STL::FWriter &out=begin();
+			for(T it=first;it!=second;it++)	out<<(*it).first<<' '<<(*it).second<<'\n';
+			out.flush();
 		}
 		//输出由二元组组成的数组，每个二元组一行。
-		template<typename T> inline void print_sequence_pair(std::vector<T> s){
-			for(T i:s)	std::cout<<i.first<<" "<<i.second<<'\n';
+		template<typename T> inline void print_sequence_pair(const std::vector<T> &s){
+			print_sequence_pair(s.begin(),s.end());
 		}
 		//输出二维数组，每个维度的数组一行。
-		template<typename T> inline void print_sequence_of_sequence(std::vector<std::vector<T>> s){
-			for(std::vector<T> i:s){
-				for(T j:i)	std::cout<<j<<" ";
-				std::cout<<'\n';
+		template<typename T> inline void print_sequence_of_sequence(const std::vector<std::vector<T>> &s){
+			FESDRER_STAT_CALL("RandomPrint.print_sequence_of_sequence");FESDRER_STAT_PHASE(print);
+			FESDRER_STL::FWriter &out=begin();
+			for(const std::vector<T> &i:s){
+				for(const T &j:i)	out<<j<<' ';
+				out<<'\n';
 			}
+			out.flush();
 		}
 		/*
 		输出图中的每条边 (x,y)，每行输出一条边，格式为 "x y"。
 		支持随机生成每条边的权值，支持输出给定的权值。
 		*/
-		inline void print_graph(std::vector<std::pair<int,int>> graph){
-			for(std::pair<int,int> i:graph)	std::cout<<i.first<<" "<<i.second<<'\n';
+		inline void print_graph(const std::vector<std::pair<int,int>> &graph){
+			FESDRER_STAT_CALL("RandomPrint.print_graph");FESDRER_STAT_PHASE(print);
+			FESDRER_STL::FWriter &out=begin();
+			for(const std::pair<int,int> &i:graph)	out<<i.first<<' '<<i.second<<'\n';
+			out.flush();
 		}
 		/*
 		输出图中的每条边 (x,y)，每行输出一条边，格式为 "x y"。
 		支持随机生成每条边的权值，支持输出给定的权值。
 		*/
-		inline void print_graph(std::vector<std::pair<int,int>> graph,long long l,long long r){
-			for(std::pair<int,int> i:graph)	std::cout<<i.first<<" "<<i.second<<" "<<random(l,r)<<'\n';
+		inline void print_graph(const std::vector<std::pair<int,int>> &graph,long long l,long long r){
+			FESDRER_STAT_CALL("RandomPrint.print_graph");FESDRER_STAT_PHASE(print);
+			FESDRER_STL::FWriter &out=begin();
+			FSampler R(l,r);
+			for(const std::pair<int,int> &i:graph)	out<<i.first<<' '<<i.second<<' '<<R()<<'\n';
+			out.flush();
 		}
 		/*
 		输出图中的每条边 (x,y)，每行输出一条边，格式为 "x y"。
 		支持随机生成每条边的权值，支持输出给定的权值。
 		*/
-		inline void print_graph(std::vector<std::pair<std::pair<int,int>,int>> graph){
-			for(std::pair<std::pair<int,int>,int> i:graph)	std::cout<<i.first.first<<" "<<i.first.second<<" "<<i.second<<'\n';
+		inline void print_graph(const std::vector<std::pair<std::pair<int,int>,int>> &graph){
+			FESDRER_STAT_CALL("RandomPrint.print_graph");FESDRER_STAT_PHASE(print);
+			FESDRER_STL::FWriter &out=begin();
+			for(const std::pair<std::pair<int,int>,int> &i:graph)	out<<i.first.first<<' '<<i.first.second<<' '<<i.second<<'\n';
+			out.flush();
+		}
+		/*
+		以二进制格式输出图中的每条边，格式见 FESDRER_STL::decode_text，用 FESDRER_STL::decode_text 或 fesdrerconv 可以转回 print_graph 的文本格式。
+		print_graph_binary 每条边定长 8 字节（带权值为 16 字节），print_graph_varint 用差分和变长编码，通常每条边只要 4~6 字节。
+		sorted 为 true 时先按 (x,y) 排序（会改变边的顺序），相邻的边的差更小，编码更短。
+		*/
+		inline void print_graph_binary(const std::vector<std::pair<int,int>> &graph){
+			FESDRER_STAT_CALL("RandomPrint.print_graph_binary");FESDRER_STAT_PHASE(print);
+			edge_block(graph.size(),0,0,[&](size_t i){return graph[i];},[](size_t){return 0ll;});
+		}
+		inline void print_graph_binary(const std::vector<std::pair<std::pair<int,int>,int>> &graph){
+			FESDRER_STAT_CALL("RandomPrint.print_graph_binary");FESDRER_STAT_PHASE(print);
+			edge_block(graph.size(),0,1,[&](size_t i){return graph[i].first;},[&](size_t i){return (long long)graph[i].second;});
+		}
+		inline void print_graph_varint(const std::vector<std::pair<int,int>> &graph,bool sorted=0){
+			FESDRER_STAT_CALL("RandomPrint.print_graph_varint");FESDRER_STAT_PHASE(print);
+			if(!sorted)	return edge_block(graph.size(),1,0,[&](size_t i){return graph[i];},[](size_t){return 0ll;});
+			std::vector<std::pair<int,int>> g(graph);
+			std::sort(g.begin(),g.end());
+			edge_block(g.size(),1,0,[&](size_t i){return g[i];},[](size_t){return 0ll;});
+		}
+		inline void print_graph_varint(const std::vector<std::pair<std::pair<int,int>,int>> &graph,bool sorted=0){
+			FESDRER_STAT_CALL("RandomPrint.print_graph_varint");FESDRER_STAT_PHASE(print);
+			if(!sorted)	return edge_block(graph.size(),1,1,[&](size_t i){return graph[i].first;},[&](size_t i){return (long long)graph[i].second;});
+			std::vector<std::pair<std::pair<int,int>,int>> g(graph);
+			std::sort(g.begin(),g.end());
+			edge_block(g.size(),1,1,[&](size_t i){return g[i].first;},[&](size_t i){return (long long)g[i].second;});
+		}
+		//输出父亲数组表示的树上第 2 到 n 号节点的父亲，fa[i] 为 i 的父亲，下标从 1 开始，根节点为 1。
+		inline void print_tree_father(const std::vector<int> &fa){
+			FESDRER_STAT_CALL("RandomPrint.print_tree_father");FESDRER_STAT_PHASE(print);
+			FESDRER_STL::FWriter &out=begin();
+			for(int i=2;i<int(fa.size());i++)	out<<fa[i]<<' ';
+			out<<'\n';
+			out.flush();
 		}
 		//输出树上第 2 到 n 号节点的父亲（根节点为 1）
-		inline void print_tree_father(std::vector<std::pair<int,int>> tree){
+		inline void print_tree_father(const std::vector<std::pair<int,int>> &tree){
+			FESDRER_STAT_CALL("RandomPrint.print_tree_father");FESDRER_STAT_PHASE(print);
 			int n=int(tree.size())+1;
 			std::vector<int> fa(n,0);
 			std::vector<std::vector<int>> e(n,std::vector<int>(0));
 			std::queue<int> q;
-			for(std::pair<int,int> &edges:tree){
+			for(const std::pair<int,int> &edges:tree){
 				e[edges.first-1].push_back(edges.second);
 				e[edges.second-1].push_back(edges.first);
 			}
@@ -281,8 +1804,10 @@ namespace FESDRER_RAND{
 					q.push(y);
 				}
 			}
-			for(int i=1;i<n;i++)	std::cout<<fa[i]<<" ";
-			std::cout<<'\n';
+			FESDRER_STL::FWriter &out=begin();
+			for(int i=1;i<n;i++)	out<<fa[i]<<' ';
+			out<<'\n';
+			out.flush();
 		}
 	};
 	static RANDOMPRINT RandomPrint;
@@ -293,45 +1818,27 @@ namespace FESDRER_RAND{
 	public:
 		//返回 [l,r] 中除了 S 中元素外的 p 个不同的元素。不调用 S 代表 S 为空。
 		template<typename T> inline std::vector<T> random_different(T l,T r,int p){
+			FESDRER_STAT_CALL("RandomAnother.random_different");
 			assert(r-l+1>=p);
-			if(p==0)	return std::vector<T>(0);
-			std::vector<T> now(0);
-			if((r-l+1)/p<=10){
-				for(T i=l;i<=r;i++)	now.push_back(i);
-				RandomBasic.random_shuffle(now.begin(),now.end());
-				int nowsiz=int(now.size());
-				while(nowsiz>p)	now.pop_back(),nowsiz--;
-				return now;
-			}
-			std::unordered_set<T> S;S.clear();
-			while(p--){
-				T x=random(l,r);
-				while(S.find(x)!=S.end())	x=random(l,r);
-				now.push_back(x),S.insert(x);
-			}
+			std::vector<long long> id=RandomDistinct.sample((long long)(r-l)+1,p);
+			std::vector<T> now(p);
+			for(int i=0;i<p;i++)	now[i]=T(l+id[i]);
 			return now;
 		}
 		//返回 [l,r] 中除了 S 中元素外的 p 个不同的元素。不调用 S 代表 S 为空。
-		template<typename T> inline std::vector<T> random_different(T l,T r,int p,std::unordered_set<T> S){
+		template<typename T> inline std::vector<T> random_different(T l,T r,int p,const std::unordered_set<T> &S){
+			FESDRER_STAT_CALL("RandomAnother.random_different");
 			assert(r-l+1>=p+S.size());
-			if(p==0)	return std::vector<T>(0);
-			std::vector<T> now(0);
-			if((r-l+1)/p<=10){
-				for(T i=l;i<=r;i++)	if(S.find(i)==S.end())	now.push_back(i);
-				RandomBasic.random_shuffle(now.begin(),now.end());
-				int nowsiz=int(now.size());
-				while(nowsiz>p)	now.pop_back(),nowsiz--;
-				return now;
-			}
-			while(p--){
-				T x=random(l,r);
-				while(S.find(x)!=S.end())	x=random(l,r);
-				now.push_back(x),S.insert(x);
-			}
+			std::vector<long long> ex(0);
+			for(const T &i:S)	if(l<=i&&i<=r)	ex.push_back((long long)(i-l));
+			std::vector<long long> id=RandomDistinct.sample((long long)(r-l)+1,p,ex);
+			std::vector<T> now(p);
+			for(int i=0;i<p;i++)	now[i]=T(l+id[i]);
 			return now;
 		}
 		//将 [l,r] 中的数分成 p 份。
 		inline std::vector<std::vector<int>> random_divide(int l,int r,int p){
+			FESDRER_STAT_CALL("RandomAnother.random_divide");
 			if(l>r&&p==0)	return std::vector<std::vector<int>>(0);
 			assert(p>=1&&p<=r-l+1);
 			std::vector<int> idnum(0);
@@ -348,7 +1855,8 @@ namespace FESDRER_RAND{
 			return spread;
 		}
 		//将 [l,r] 中的数分成 p 份，并通过 limits 限制每份数量上限。
-		inline std::vector<std::vector<int>> random_divide(int l,int r,int p,std::vector<int> limits){
+		inline std::vector<std::vector<int>> random_divide(int l,int r,int p,const std::vector<int> &limits){
+			FESDRER_STAT_CALL("RandomAnother.random_divide");
 			if(l>r&&p==0)	return std::vector<std::vector<int>>(0);
 			long long sum=0;
 			for(int i:limits)	sum+=i;
@@ -359,11 +1867,13 @@ namespace FESDRER_RAND{
 			for(int i=0;i<p;i++)	id[i]=i;
 			sort(id.begin(),id.end(),[&](const int x,const int y){return limits[x]>limits[y];});
 			std::vector<std::vector<int>> spread(p);
-			FESDRER_STL::FVector choose;
-			int top=0;
+			FESDRER_STL::FSwapSet choose;
+			choose.reserve(p);
+			int top=0,open=p;
+			while(open>0&&limits[id[open-1]]<=1)	open--;//上限为 1 的桶已经满了，不再打开
 			for(int i=0;i<p;i++)	spread[i].assign(1,idnum[i]);
 			for(int i=p;i<r-l+1;i++){
-				int ids=(top==p?random(0,choose.size()-1):random(0,choose.size()));
+				int ids=(top==open?random(0,choose.size()-1):random(0,choose.size()));
 				if(ids==choose.size())	choose.push_back(top++);
 				spread[choose[ids]].push_back(idnum[i]);
 				if(limits[id[choose[ids]]]==int(spread[choose[ids]].size()))	choose.erase(ids);
@@ -373,31 +1883,49 @@ namespace FESDRER_RAND{
 			return ret;
 		}
 		//将 n 个数分成 p 份，并通过 limits 限制每份数量上限（limits 为空（即保持默认）表示无上限）。
-		inline std::vector<int> random_divide_num(int n,int p,std::vector<int> limits=std::vector<int>(0)){
+		inline std::vector<int> random_divide_num(int n,int p,const std::vector<int> &limits=std::vector<int>(0)){
+			FESDRER_STAT_CALL("RandomAnother.random_divide_num");
 			if(n==0&&p==0)	return std::vector<int>(0);
 			assert(p>=1&&p<=n);
-			if(limits.empty())	for(int i=1;i<=p;i++)	limits.push_back(n);
-			else{
+			if(!limits.empty()){
 				long long sum=0;
 				for(int i:limits)	sum+=i;
-				assert(int(limits.size())==p);
+				assert(int(limits.size())==p&&sum>=n);
 			}
+			auto limit=[&](int x){return limits.empty()?n:limits[x];};
 			std::vector<int> id(p);
 			for(int i=0;i<p;i++)	id[i]=i;
-			sort(id.begin(),id.end(),[&](const int x,const int y){return limits[x]>limits[y];});
+			if(!limits.empty())	sort(id.begin(),id.end(),[&](const int x,const int y){return limits[x]>limits[y];});
 			std::vector<int> spread(p);
-			FESDRER_STL::FVector choose;
-			int top=0;
+			FESDRER_STL::FSwapSet choose;
+			choose.reserve(p);
+			int top=0,open=p;
+			while(open>0&&limit(id[open-1])<=1)	open--;//上限为 1 的桶已经满了，不再打开
 			for(int i=0;i<p;i++)	spread[i]=1;
 			for(int i=p;i<n;i++){
-				int ids=(top==p?random(0,choose.size()-1):random(0,choose.size()));
+				int ids=(top==open?random(0,choose.size()-1):random(0,choose.size()));
 				if(ids==choose.size())	choose.push_back(top++);
-				spread[choose[ids]]++;
-				if(limits[id[choose[ids]]]==int(spread[choose[ids]]))	choose.erase(ids);
+				int now=choose[ids];
+				spread[now]++;
+				if(limit(id[now])==spread[now])	choose.erase(ids);
 			}
 			std::vector<int> ret(p);
 			for(int i=0;i<p;i++)	ret[id[i]]=spread[i];
-			return spread;
+			return ret;
+		}
+		//将 n 个数分成 p 份，每份至少一个，所有 C(n-1,p-1) 种分法等概率。只求每份的数量，用隔板法直接抽出 p-1 个隔板位置，期望 O(p)。
+		inline std::vector<int> random_divide_uniform(int n,int p){
+			FESDRER_STAT_CALL("RandomAnother.random_divide_uniform");
+			if(n==0&&p==0)	return std::vector<int>(0);
+			assert(p>=1&&p<=n);
+			std::vector<int> ret(0);
+			ret.reserve(p);
+			long long last=0;
+			RandomDistinct.sample_sorted(n-1,p-1,[&](long long x){
+				ret.push_back(int(x+1-last)),last=x+1;
+			});
+			ret.push_back(int(n-last));
+			return ret;
 		}
 	};
 	static RANDOMANOTHER RandomAnother;
@@ -406,16 +1934,35 @@ namespace FESDRER_RAND{
 	//图操作辅助函数。
 	class RANDOMGRAPHTOOL{
 	public:
-		//打乱 n 个节点的图的节点编号，不改变 1 号节点和 n 号节点。
-		inline void random_vertices(int n,std::vector<std::pair<int,int>> &edges){
+		//打乱 n 个节点的图的节点编号，不改变 1 号节点和 n 号节点。threads 为改写边时使用的线程数。
+		inline void random_vertices(int n,std::vector<std::pair<int,int>> &edges,int threads=1){
+			FESDRER_STAT_CALL("RandomGraphTool.random_vertices");FESDRER_STAT_PHASE(relabel);
 			std::vector<int> idnum;idnum.clear();
 			for(int i=2;i<n;i++)	idnum.push_back(i);
 			RandomBasic.random_shuffle(idnum.begin(),idnum.end());
 			idnum.insert(idnum.begin(),1),idnum.push_back(n);
-			for(std::pair<int,int> &i:edges)	i.first=idnum[i.first-1],i.second=idnum[i.second-1];
+			const int block=1<<16;
+			int m=int(edges.size());
+			FESDRER_STL::parallel_for((m+block-1)/block,threads,[&](int c){
+				for(int i=c*block;i<std::min(m,(c+1)*block);i++)	edges[i].first=idnum[edges[i].first-1],edges[i].second=idnum[edges[i].second-1];
+			});
+		}
+		//打乱 n 个节点的图的节点编号，只改写 [first,last) 中的边，不改变 1 号节点和 n 号节点。
+		template<typename T> inline void random_vertices(int n,T first,T last,int threads=1){
+			FESDRER_STAT_CALL("RandomGraphTool.random_vertices");FESDRER_STAT_PHASE(relabel);
+			std::vector<int> idnum;idnum.clear();
+			for(int i=2;i<n;i++)	idnum.push_back(i);
+			RandomBasic.random_shuffle(idnum.begin(),idnum.end());
+			idnum.insert(idnum.begin(),1),idnum.push_back(n);
+			const int block=1<<16;
+			long long m=last-first;
+			FESDRER_STL::parallel_for(int((m+block-1)/block),threads,[&](int c){
+				for(long long i=1ll*c*block;i<std::min(m,1ll*(c+1)*block);i++)	first[i].first=idnum[first[i].first-1],first[i].second=idnum[first[i].second-1];
+			});
 		}
 		//打乱 n 个节点的图的节点编号，不改变 1 号节点和 n 号节点。
 		inline void random_vertices(int n,std::vector<std::pair<std::pair<int,int>,int>> &edges){
+			FESDRER_STAT_CALL("RandomGraphTool.random_vertices");FESDRER_STAT_PHASE(relabel);
 			std::vector<int> idnum;idnum.clear();
 			for(int i=2;i<n;i++)	idnum.push_back(i);
 			RandomBasic.random_shuffle(idnum.begin(),idnum.end());
@@ -424,9 +1971,9 @@ namespace FESDRER_RAND{
 				i.first.first=idnum[i.first.first-1],i.first.second=idnum[i.first.second-1];
 		}
 		//返回 n 个节点的图中每个点的出边到达的点。directional 表示是否有向。下标从 0 开始。
-		inline std::vector<std::vector<int>> get_outedge(int n,std::vector<std::pair<int,int>> edges,bool directional){
+		inline std::vector<std::vector<int>> get_outedge(int n,const std::vector<std::pair<int,int>> &edges,bool directional){
 			std::vector<std::vector<int>> e(n,std::vector<int>(0));
-			for(std::pair<int,int> &it:edges){
+			for(const std::pair<int,int> &it:edges){
 				e[it.first-1].push_back(it.second);
 				if(!directional)	e[it.second-1].push_back(it.first);
 			}
@@ -434,20 +1981,15 @@ namespace FESDRER_RAND{
 		}
 		//清空 n 个节点的图中的重边。directional 表示是否有向。
 		inline void clear_repeated_edges(int n,std::vector<std::pair<int,int>> &graph,bool directional){
-			std::unordered_set<long long> S;S.clear();
 			auto Gid=[&](int x,int y){
 				if(!directional&&x>y)	std::swap(x,y);
 				return 1ll*(x-1)*n+y;
 			};
-			int m=int(graph.size()),_=0;
-			for(int i=0;i<m;i++){
-				if(S.find(Gid(graph[i].first,graph[i].second))==S.end()){
-					if(_==i)	_++;
-					else	graph[_++]=graph[i];
-					S.insert(Gid(graph[i].first,graph[i].second));
-				}
-			}
-			while(m>_)	graph.pop_back(),m--;
+			std::vector<long long> ids(graph.size());
+			for(int i=0;i<int(graph.size());i++)	ids[i]=Gid(graph[i].first,graph[i].second);
+			std::vector<int> keep=RandomDistinct.first_occurrence(ids);
+			for(int i=0;i<int(keep.size());i++)	graph[i]=graph[keep[i]];
+			graph.resize(keep.size());
 		}
 		//在 n 个节点的图中随即加入 addnum 个自环（不保证没有重复的自环）。
 		inline void add_self_rings(int n,std::vector<std::pair<int,int>> &graph,int addnum){
@@ -465,16 +2007,28 @@ namespace FESDRER_RAND{
 		*/
 		template<typename __Rnm,typename __Rgraph> inline std::vector<std::pair<int,int>> random_unconnected(int N,int M,__Rnm Rnm,__Rgraph Rgraph,double opt=5){
 			std::vector<std::pair<int,int>> graph(0);
+			random_unconnected(graph,N,M,Rnm,[&](const std::vector<int> &number,std::vector<std::pair<int,int>> &out){
+				std::vector<std::pair<int,int>> now=Rgraph(number);
+				out.insert(out.end(),now.begin(),now.end());
+			},opt);
+			return graph;
+		}
+		/*
+		随机生成一个不连通图，边追加到 graph 的末尾。
+		Rgraph(vector<int>,G&) 是图生成函数，接受 Rnm 返回的参数并把生成的图直接追加到第二个参数的末尾，之后在原处整体平移编号，不产生中间数组。
+		其余参数与上面相同。
+		*/
+		template<typename G,typename __Rnm,typename __Rgraph> inline void random_unconnected(G &graph,int N,int M,__Rnm Rnm,__Rgraph Rgraph,double opt=5){
 			int cnt=0;
 			opt=1/opt;
 			while(true){
 				std::vector<int> number=Rnm(N*opt,M*opt);
 				if(number[0]==-1)	break;
-				std::vector<std::pair<int,int>> now=Rgraph(number);
-				for(std::pair<int,int> it:now)	graph.push_back({it.first+cnt,it.second+cnt});
+				size_t st=graph.size();
+				Rgraph(number,graph);
+				for(size_t i=st;i<graph.size();i++)	graph[i].first+=cnt,graph[i].second+=cnt;
 				N-=number[0],M-=number[1],cnt+=number[0];
 			}
-			return graph;
 		}
 	};
 	static RANDOMGRAPHTOOL RandomGraphTool;
@@ -482,6 +2036,68 @@ namespace FESDRER_RAND{
 
 	//随机树生成函数。
 	class RANDOMTREE{
+	private:
+		//[1,n] 的子集，支持插入、删除和求从小到大第 k 个（从 0 开始），都是 O(log n)。
+		class RankSet{
+		private:
+			std::vector<int> fen;
+			int n,cnt,lg;
+		public:
+			RankSet(int n):fen(n+1,0),n(n),cnt(0),lg(1){
+				while(lg*2<=n)	lg*=2;
+			}
+			inline int size() const{
+				return cnt;
+			}
+			inline void insert(int x){
+				for(cnt++;x<=n;x+=x&-x)	fen[x]++;
+			}
+			inline void erase(int x){
+				for(cnt--;x<=n;x+=x&-x)	fen[x]--;
+			}
+			inline int kth(int k){
+				int pos=0;
+				for(int step=lg;step;step>>=1)
+					if(pos+step<=n&&fen[pos+step]<=k)	pos+=step,k-=fen[pos];
+				return pos+1;
+			}
+		};
+		//把父亲数组表示的树换根为 r，只需要把 r 到原来根的路径反向。
+		inline void reroot(std::vector<int> &fa,int r){
+			int pre=0;
+			while(r)	std::swap(fa[r],pre),std::swap(pre,r);
+		}
+		//随机打乱父亲数组表示的树的节点编号，不改变 1 号节点。
+		inline void relabel(std::vector<int> &fa){
+			int n=int(fa.size())-1;
+			std::vector<int> id(n+1),ret(n+1,0);
+			for(int i=0;i<=n;i++)	id[i]=i;
+			RandomBasic.random_shuffle(id.begin()+std::min(n+1,2),id.end());
+			for(int i=1;i<=n;i++)	ret[id[i]]=id[fa[i]];
+			fa.swap(ret);
+		}
+		/*
+		线性 Prufer 解码。deg[i] 为 i 在编码中出现的次数加 1，next() 依次给出编码中的数，结果以 n 为根，再换根为 1。
+		*/
+		template<typename F> inline void prufer_decode(int n,std::vector<int> &fa,std::vector<int> &deg,F next){
+			fa.assign(n+1,0);
+			if(n<=1)	return;
+			int ptr=1;
+			while(deg[ptr]!=1)	ptr++;
+			int leaf=ptr;
+			for(int i=0;i<n-2;i++){
+				int x=next();
+				fa[leaf]=x;
+				if(--deg[x]==1&&x<ptr)	leaf=x;
+				else{
+					ptr++;
+					while(deg[ptr]!=1)	ptr++;
+					leaf=ptr;
+				}
+			}
+			fa[leaf]=n;
+			reroot(fa,1);
+		}
 	public:
 		/*
 		随机生成一个 n 个点的以 1 为根的树。
@@ -489,13 +2105,16 @@ namespace FESDRER_RAND{
 		可以通过 vertives_rand 控制是否打乱节点编号，打乱后根节点仍然是 1，不打乱则父亲编号永远小于儿子。
 		*/
 		inline std::vector<std::pair<int,int>> random_tree(int n,double rho=2,bool vertices_rand=1){
+			FESDRER_STAT_CALL("RandomTree.random_tree");FESDRER_STAT_PHASE(tree);
 			std::vector<std::pair<int,int>> tree;tree.clear();
-			for(int i=2;i<=n;i++)	tree.push_back({random(1,i-1,rho),i});
+			FSampler R(0,0,rho);
+			for(int i=2;i<=n;i++)	tree.push_back({R(1,i-1),i});
 			if(vertices_rand)	RandomGraphTool.random_vertices(n,tree);
 			return tree;
 		}
 		//随机生成一个菊花，根节点为 1。
 		inline std::vector<std::pair<int,int>> random_flower_tree(int n){
+			FESDRER_STAT_CALL("RandomTree.random_flower_tree");FESDRER_STAT_PHASE(tree);
 			std::vector<std::pair<int,int>> tree;tree.clear();
 			int root=1;
 			for(int i=1;i<=n;i++)	if(i!=root)	tree.push_back({i,root});
@@ -503,6 +2122,7 @@ namespace FESDRER_RAND{
 		}
 		//随机生成一条链，不保证节点 1 为链的一端。
 		inline std::vector<std::pair<int,int>> random_chain_tree(int n){
+			FESDRER_STAT_CALL("RandomTree.random_chain_tree");FESDRER_STAT_PHASE(tree);
 			std::vector<std::pair<int,int>> tree;tree.clear();
 			for(int i=1;i<n;i++)	tree.push_back({i,i+1});
 			RandomGraphTool.random_vertices(n,tree);
@@ -513,6 +2133,7 @@ namespace FESDRER_RAND{
 		opt 在 [0,100]，为链约占总点数的百分比。
 		*/
 		inline std::vector<std::pair<int,int>> random_lantern_tree(int n,int opt=50){
+			FESDRER_STAT_CALL("RandomTree.random_lantern_tree");FESDRER_STAT_PHASE(tree);
 			std::vector<std::pair<int,int>> tree;tree.clear();
 			int root=1,teil=root;
 			for(int i=1;i<=n;i++)	if(i!=root){
@@ -520,32 +2141,161 @@ namespace FESDRER_RAND{
 				if(test>opt)	tree.push_back({i,root});
 				else	tree.push_back({i,teil}),teil=i;
 			}
-			RandomGraphTool.random_vertices(n,tree);
-			return tree;
+			RandomGraphTool.random_vertices(n,tree);
+			return tree;
+		}
+		/*
+		随机生成一颗二叉树。
+		opt 在 [0,100]，为右儿子约占总儿子的百分比。
+		rho 在 [0,+infinity]，其越大，树的深度越大。
+		可以通过 vertives_rand 控制是否打乱节点编号，打乱后根节点仍然是 1，不打乱则父亲编号永远小于儿子。
+		*/
+		inline std::vector<std::pair<int,int>> random_binary_tree(int n,int opt=50,double rho=1,bool vertices_rand=1){
+			FESDRER_STAT_CALL("RandomTree.random_binary_tree");FESDRER_STAT_PHASE(tree);
+			//lson/rson 是还缺左/右儿子的点的集合，按编号从小到大数第 id 个用树状数组求出。
+			RankSet lson(n),rson(n);
+			std::vector<std::pair<int,int>> tree;tree.clear();
+			tree.reserve(std::max(0,n-1));
+			FSampler R(0,0,rho);
+			lson.insert(1),rson.insert(1);
+			for(int i=2;i<=n;i++){
+				int test=random(1,100),fa;
+				if(test>opt)	fa=lson.kth(int(R(0,lson.size()-1))),lson.erase(fa);
+				else	fa=rson.kth(int(R(0,rson.size()-1))),rson.erase(fa);
+				tree.push_back({fa,i}),lson.insert(i),rson.insert(i);
+			}
+			if(vertices_rand)	RandomGraphTool.random_vertices(n,tree);
+			return tree;
+		}
+		/*
+		随机生成一颗二叉树，所有 n 个点的二叉树形态等概率（Remy 算法），根节点为 1。
+		可以通过 vertives_rand 控制是否打乱节点编号，打乱后根节点仍然是 1，不打乱则按 bfs 序编号，父亲编号永远小于儿子。
+		*/
+		inline std::vector<std::pair<int,int>> random_uniform_binary_tree(int n,bool vertices_rand=1){
+			FESDRER_STAT_CALL("RandomTree.random_uniform_binary_tree");FESDRER_STAT_PHASE(tree);
+			std::vector<std::pair<int,int>> tree;tree.clear();
+			if(n<=1)	return tree;
+			//Remy 算法生成有 n 个内部点的满二叉树，去掉叶子就是均匀的 n 个点的二叉树。奇数编号是内部点，其余是叶子。
+			std::vector<int> fa(2*n+1,-1),son(2*(2*n+1),-1);
+			int root=0;
+			for(int k=1;k<=n;k++){
+				int x=int(random_bounded(2*k-1)),d=int(random_bounded(2)),v=2*k-1,w=2*k;
+				if(fa[x]==-1)	root=v;
+				else	son[2*fa[x]+(son[2*fa[x]+1]==x)]=v;
+				fa[v]=fa[x],fa[x]=v,fa[w]=v;
+				son[2*v+d]=x,son[2*v+(d^1)]=w;
+			}
+			//把内部点按 bfs 序编号为 1~n。
+			std::vector<int> id(2*n+1,0),que(1,root);
+			que.reserve(n);
+			id[root]=1;
+			for(int h=0;h<int(que.size());h++){
+				int x=que[h];
+				for(int d=0;d<2;d++){
+					int y=son[2*x+d];
+					if(son[2*y]==-1)	continue;
+					id[y]=int(que.size())+1,que.push_back(y);
+					tree.push_back({id[x],id[y]});
+				}
+			}
+			if(vertices_rand)	RandomGraphTool.random_vertices(n,tree);
+			return tree;
+		}
+		/*
+		下面的树都以父亲数组返回：fa[i] 为 i 的父亲，下标从 1 开始，根节点为 1 且 fa[1]=0，fa[0] 不使用。
+		父亲数组可以直接交给 RandomPrint.print_tree_father 输出，也可以用 father_to_tree 转成边的数组。
+		*/
+		//随机生成一个 n 个点的以 1 为根的树，与 random_tree 相同，但返回父亲数组。
+		inline std::vector<int> random_tree_father(int n,double rho=2,bool vertices_rand=1){
+			FESDRER_STAT_CALL("RandomTree.random_tree_father");FESDRER_STAT_PHASE(tree);
+			std::vector<int> fa(n+1,0);
+			FSampler R(0,0,rho);
+			for(int i=2;i<=n;i++)	fa[i]=int(R(1,i-1));
+			if(vertices_rand)	relabel(fa);
+			return fa;
+		}
+		/*
+		随机生成一个 n 个点的无根树，所有 n^(n-2) 种有标号树等概率，用线性的 Prufer 解码，O(n)。
+		编码不保存下来，统计完每个数的出现次数后恢复随机数引擎的状态再生成一遍，所以只需要两个长度为 n 的数组。
+		*/
+		inline std::vector<int> random_prufer_tree(int n){
+			FESDRER_STAT_CALL("RandomTree.random_prufer_tree");FESDRER_STAT_PHASE(tree);
+			std::vector<int> fa,deg(n+1,1);
+			FEngine saved=rng_64;
+			for(int i=0;i<n-2;i++)	deg[random_bounded(n)+1]++;
+			rng_64=saved;
+			prufer_decode(n,fa,deg,[&](){return int(random_bounded(n))+1;});
+			return fa;
+		}
+		/*
+		随机生成一个 n 个点的树，其中 i 号节点的度数为 degree[i-1]，所有满足条件的有标号树等概率，O(n)。
+		n>1 时 degree 中每个数都至少为 1，且总和为 2n-2；n=1 时 degree 为 {0}（也接受 {1}）。
+		*/
+		inline std::vector<int> random_degree_tree(const std::vector<int> &degree){
+			FESDRER_STAT_CALL("RandomTree.random_degree_tree");FESDRER_STAT_PHASE(tree);
+			int n=int(degree.size());
+			long long sum=0;
+			for(int i:degree)	assert(i>=(n==1?0:1)),sum+=i;
+			assert(n==1?degree[0]==0||degree[0]==1:sum==2ll*n-2);
+			std::vector<int> fa,deg(n+1,1),code(0);
+			code.reserve(std::max(0,n-2));
+			for(int i=1;i<=n&&n>1;i++)	for(int j=1;j<degree[i-1];j++)	code.push_back(i);
+			RandomBasic.random_shuffle(code.begin(),code.end());
+			for(int x:code)	deg[x]++;
+			int pos=0;
+			prufer_decode(n,fa,deg,[&](){return code[pos++];});
+			return fa;
+		}
+		//随机生成一个 n 个点的树，每个点的度数都不超过 maxd，先随机分配度数再按度数生成。
+		inline std::vector<int> random_max_degree_tree(int n,int maxd){
+			FESDRER_STAT_CALL("RandomTree.random_max_degree_tree");FESDRER_STAT_PHASE(tree);
+			assert(n<=2||maxd>=2);
+			if(n<=1)	return std::vector<int>(n+1,0);
+			return random_degree_tree(RandomAnother.random_divide_num(2*n-2,n,std::vector<int>(n,std::min(maxd,n-1))));
+		}
+		/*
+		随机生成一个 n 个点、以 1 为根、深度恰好为 h 的树（根的深度为 0），h 在 [n>1,n-1]。
+		先放一条从 1 开始的长度为 h 的链，其余的点随机挂在深度小于 h 的点下面。
+		*/
+		inline std::vector<int> random_height_tree(int n,int h,bool vertices_rand=1){
+			FESDRER_STAT_CALL("RandomTree.random_height_tree");FESDRER_STAT_PHASE(tree);
+			assert(n>=1&&h>=(n>1)&&h<=n-1);
+			std::vector<int> fa(n+1,0),dep(n+1,0),can(0);
+			can.reserve(n);
+			for(int i=2;i<=h+1;i++)	fa[i]=i-1,dep[i]=dep[i-1]+1;
+			for(int i=1;i<=h;i++)	can.push_back(i);
+			for(int i=h+2;i<=n;i++){
+				fa[i]=can[random_bounded(can.size())],dep[i]=dep[fa[i]]+1;
+				if(dep[i]<h)	can.push_back(i);
+			}
+			if(vertices_rand)	relabel(fa);
+			return fa;
 		}
 		/*
-		随机生成一颗二叉树。
-		opt 在 [0,100]，为右儿子约占总儿子的百分比。
-		rho 在 [0,+infinity]，其越大，树的深度越大。
-		可以通过 vertives_rand 控制是否打乱节点编号，打乱后根节点仍然是 1，不打乱则父亲编号永远小于儿子。
+		随机生成一个 n 个点、直径恰好为 d 的树，以直径的一个端点 1 为根。d 在 [min(n-1,2),n-1]。
+		先放一条长为 d 的链，链上第 j 个点最多再向外延伸 min(j,d-j) 层，其余的点随机挂在还能延伸的点下面。
 		*/
-		inline std::vector<std::pair<int,int>> random_binary_tree(int n,int opt=50,double rho=1,bool vertices_rand=1){
-			std::vector<int> lson,rson;lson.clear(),rson.clear();
-			std::vector<std::pair<int,int>> tree;tree.clear();
-			lson.push_back(1),rson.push_back(1);
-			for(int i=2;i<=n;i++){
-				int test=random(1,100),fa;
-				if(test>opt){
-					int id=random(0,int(lson.size())-1,rho);
-					fa=lson[id],lson.erase(lson.begin()+id);
-				}
-				else{
-					int id=random(0,int(rson.size())-1,rho);
-					fa=rson[id],rson.erase(rson.begin()+id);
-				}
-				tree.push_back({fa,i}),lson.push_back(i),rson.push_back(i);
+		inline std::vector<int> random_diameter_tree(int n,int d,bool vertices_rand=1){
+			FESDRER_STAT_CALL("RandomTree.random_diameter_tree");FESDRER_STAT_PHASE(tree);
+			assert(n>=1&&d>=std::min(n-1,2)&&d<=n-1);
+			std::vector<int> fa(n+1,0),rest(n+1,0),can(0);
+			can.reserve(n);
+			for(int i=1;i<=d+1;i++){
+				fa[i]=i-1,rest[i]=std::min(i-1,d-i+1);
+				if(rest[i])	can.push_back(i);
 			}
-			if(vertices_rand)	RandomGraphTool.random_vertices(n,tree);
+			for(int i=d+2;i<=n;i++){
+				fa[i]=can[random_bounded(can.size())],rest[i]=rest[fa[i]]-1;
+				if(rest[i])	can.push_back(i);
+			}
+			if(vertices_rand)	relabel(fa);
+			return fa;
+		}
+		//把父亲数组转成边的数组，每条边为 {父亲,儿子}。
+		inline std::vector<std::pair<int,int>> father_to_tree(const std::vector<int> &fa){
+			std::vector<std::pair<int,int>> tree(0);
+			tree.reserve(std::max(0,int(fa.size())-2));
+			for(int i=1;i<int(fa.size());i++)	if(fa[i])	tree.push_back({fa[i],i});
 			return tree;
 		}
 	};
@@ -554,14 +2304,100 @@ namespace FESDRER_RAND{
 
 	//随机图生成函数。
 	class RANDOMGRAPH{
+	private:
+		/*
+		把 n 个点的图中所有允许出现的边按字典序编号为 [0,U)，无向图只编号 x<=y 的边。
+		有无自环和方向是模板参数，编码和解码中的判断在编译时就确定了。
+		*/
+		template<bool SelfRings,bool Directional> struct EdgeCodec{
+			int n;
+			long long w,U;
+			inline explicit EdgeCodec(int n):n(n){
+				w=n+(SelfRings?1:0),U=1ll*n*(n-1)/(Directional?1:2)+(SelfRings?n:0);
+			}
+			inline long long offset(long long x) const{
+				return (x-1)*w-(x-1)*x/2;
+			}
+			inline long long id(int x,int y) const{
+				if(Directional)	return SelfRings?1ll*(x-1)*n+y-1:1ll*(x-1)*(n-1)+y-1-(y>x);
+				if(x>y)	std::swap(x,y);
+				return offset(x)+y-x-(SelfRings?0:1);
+			}
+			inline std::pair<int,int> edge(long long id) const{
+				if(Directional){
+					if(SelfRings)	return std::make_pair(int(id/n)+1,int(id%n)+1);
+					int x=int(id/(n-1))+1,y=int(id%(n-1))+1;
+					return std::make_pair(x,y+(y>=x));
+				}
+				long long x=(long long)((2*w-1-sqrtl((long double)(2*w-1)*(2*w-1)-8.0L*id))/2)+1;
+				while(x>1&&offset(x)>id)	x--;
+				while(offset(x+1)<=id)	x++;
+				return std::make_pair(int(x),int(x+id-offset(x)+(SelfRings?0:1)));
+			}
+			//按编号从小到大依次解码时使用，x 保存上一次解码得到的起点（初始为 1），均摊 O(1)。
+			inline std::pair<int,int> edge_after(long long id,long long &x) const{
+				if(Directional){
+					long long W=n-(SelfRings?0:1);
+					while(x*W<=id)	x++;
+					int y=int(id-(x-1)*W)+1;
+					return std::make_pair(int(x),y+(!SelfRings&&y>=x));
+				}
+				while(offset(x+1)<=id)	x++;
+				return std::make_pair(int(x),int(x+id-offset(x)+(SelfRings?0:1)));
+			}
+		};
+		/*
+		允许重边时独立地随机一条边，R 在 [1,n] 中取值，Q 在 [1,n-1] 中取值。
+		没有自环时终点在其余 n-1 个点中均匀选取，不需要再修正，无向图把编号小的点放在前面。
+		*/
+		template<bool SelfRings,bool Directional> static inline std::pair<int,int> draw(const FSampler &R,const FSampler &Q,FEngine &g){
+			int x=int(R(g)),y=int(SelfRings?R(g):Q(g));
+			if(!SelfRings)	y+=(y>=x);
+			if(!Directional){
+				int a=std::min(x,y);
+				y=std::max(x,y),x=a;
+			}
+			return std::make_pair(x,y);
+		}
+		//G 是 std::vector 时边存在内存里，否则（例如 FEdgeFile）认为边存在文件里，生成时不能保存与边数同阶的数组。
+		template<typename G> struct in_memory:std::false_type{};
+		template<typename T,typename A> struct in_memory<std::vector<T,A>>:std::true_type{};
+		//graph_stream 的实现，有无自环和方向是模板参数。
+		template<bool SelfRings,bool Directional,typename F> inline void stream(int n,int m,bool connected,bool repeated_edges,bool vertices_rand,F &f){
+			FESDRER_STAT_CALL("RandomGraph.graph_stream");FESDRER_STAT_PHASE(edges);
+			assert(check(n,m,connected,repeated_edges,SelfRings,Directional));
+			EdgeCodec<SelfRings,Directional> E(n);
+			std::vector<int> idnum(n+1);
+			for(int i=0;i<=n;i++)	idnum[i]=i;
+			if(vertices_rand&&n>3)	RandomBasic.random_shuffle(idnum.begin()+2,idnum.begin()+n);
+			std::vector<long long> S(0);
+			if(connected){
+				std::vector<std::pair<int,int>> tree=RandomTree.random_tree(n,5,0);
+				for(std::pair<int,int> edge:tree)	f(idnum[edge.first],idnum[edge.second]),S.push_back(E.id(edge.first,edge.second)),m--;
+			}
+			long long row=1;
+			if(!repeated_edges)	RandomDistinct.sample_sorted(E.U,m,[&](long long id){
+				std::pair<int,int> e=E.edge_after(id,row);
+				f(idnum[e.first],idnum[e.second]);
+			},S);
+			else{
+				FSampler R(1,n),Q(1,std::max(1,n-1));
+				while(m-->0){
+					std::pair<int,int> e=draw<SelfRings,Directional>(R,Q,rng_64);
+					f(idnum[e.first],idnum[e.second]);
+				}
+			}
+		}
 	public:
+		//n 个点的图最多能有多少条边，允许重边时只要有边可选就没有限制。check 和 nm 都用它计算边数的上界。
+		static inline long long max_edges(int n,bool repeated_edges,bool self_rings,bool directional){
+			long long simple=1ll*n*(n-1)/(directional?1:2)+1ll*n*self_rings;
+			if(repeated_edges)	return simple?LLONG_MAX:0;
+			return simple;
+		}
 		//检查点数 n 和边数 m 是否合法。其余的变量是图的若干限制条件，取名直观，不做解释。
 		inline bool check(int n,int m,bool connected,bool repeated_edges,bool self_rings,bool directional){
-			bool ret=true;
-			ret&=(!(connected&&m<n-1));
-			ret&=(!(directional&&!repeated_edges&&1ll*m>1ll*n*(n-1)+n*(self_rings)));
-			ret&=(!(!directional&&!repeated_edges&&1ll*m>1ll*n*(n-1)/2+n*(self_rings)));
-			ret&=(!(n==1&&!self_rings&&m>0));
+			bool ret=!(connected&&m<n-1)&&m<=max_edges(n,repeated_edges,self_rings,directional);
 			if(!ret)	std::cerr<<"Error: "<<n<<" "<<m<<" "<<connected<<" "<<repeated_edges<<" "<<self_rings<<" "<<directional<<'\n';
 			return ret;
 		}
@@ -574,8 +2410,7 @@ namespace FESDRER_RAND{
 			if(N<3)	return std::vector<int>{-1,-1};
 			int n=random(3,N,opt),m,Ml=1,Mr=M;
 			if(connected)	Ml=n-1;
-			if(directional&&!repeated_edges)	Mr=std::min(1ll*Mr,1ll*n*(n-1)+n*(self_rings));
-			if(!directional&&!repeated_edges)	Mr=std::min(1ll*Mr,1ll*n*(n-1)/2+n*(self_rings));
+			Mr=int(std::min<long long>(Mr,max_edges(n,repeated_edges,self_rings,directional)));
 			if(Ml>Mr)	return {-1,-1};
 			m=random(Ml,Mr,opt);
 			return std::vector<int>{n,m};
@@ -584,63 +2419,101 @@ namespace FESDRER_RAND{
 		随机生成一个 n 个点 m 条边的图。
 		vertices_rand 控制是否要打乱点，若不打乱则返回的每个 pair<int,int> 中 first 总是小于等于 second，即使打乱也不改变 1 号点的编号。
 		图为有向图且连通时，数据保证从 1 号点可以到达任意一个点。
+		threads 为生成边时使用的线程数。边按固定大小分块，每块使用固定的子随机数流，因此种子相同时结果与线程数无关。
 		其余的变量是图的若干限制条件，取名直观，不做解释。
 		*/
-		inline std::vector<std::pair<int,int>> graph(int n,int m,bool connected,bool repeated_edges,bool self_rings,bool directional,bool vertices_rand=1){
-			assert(check(n,m,connected,repeated_edges,self_rings,directional));
-			auto Gid=[&](int x,int y){return 1ll*(x-1)*n+y;};
-			auto Gx=[&](long long w){return (w-1)/n+1;};
-			auto Gy=[&](long long w){return (w-1)%n+1;};
-			std::vector<std::pair<int,int>> graph;graph.clear();
-			std::unordered_set<long long> S;
-			if(connected){
+		inline std::vector<std::pair<int,int>> graph(int n,int m,bool connected,bool repeated_edges,bool self_rings,bool directional,bool vertices_rand=1,int threads=1){
+			std::vector<std::pair<int,int>> graph(0);
+			this->graph(graph,n,m,connected,repeated_edges,self_rings,directional,vertices_rand,threads);
+			return graph;
+		}
+		/*
+		随机生成一个 n 个点 m 条边的图，边追加到 graph 的末尾，参数与上面相同。
+		只在开始时按四个限制条件选择一次下面的模板版本，生成边的循环中不再判断。
+		*/
+		template<typename G,typename=typename std::enable_if<!std::is_arithmetic<G>::value>::type> inline void graph(G &graph,int n,int m,bool connected,bool repeated_edges,bool self_rings,bool directional,bool vertices_rand=1,int threads=1){
+			switch(connected*8+repeated_edges*4+self_rings*2+directional){
+				case 0:	return this->graph<0,0,0,0>(graph,n,m,vertices_rand,threads);
+				case 1:	return this->graph<0,0,0,1>(graph,n,m,vertices_rand,threads);
+				case 2:	return this->graph<0,0,1,0>(graph,n,m,vertices_rand,threads);
+				case 3:	return this->graph<0,0,1,1>(graph,n,m,vertices_rand,threads);
+				case 4:	return this->graph<0,1,0,0>(graph,n,m,vertices_rand,threads);
+				case 5:	return this->graph<0,1,0,1>(graph,n,m,vertices_rand,threads);
+				case 6:	return this->graph<0,1,1,0>(graph,n,m,vertices_rand,threads);
+				case 7:	return this->graph<0,1,1,1>(graph,n,m,vertices_rand,threads);
+				case 8:	return this->graph<1,0,0,0>(graph,n,m,vertices_rand,threads);
+				case 9:	return this->graph<1,0,0,1>(graph,n,m,vertices_rand,threads);
+				case 10:	return this->graph<1,0,1,0>(graph,n,m,vertices_rand,threads);
+				case 11:	return this->graph<1,0,1,1>(graph,n,m,vertices_rand,threads);
+				case 12:	return this->graph<1,1,0,0>(graph,n,m,vertices_rand,threads);
+				case 13:	return this->graph<1,1,0,1>(graph,n,m,vertices_rand,threads);
+				case 14:	return this->graph<1,1,1,0>(graph,n,m,vertices_rand,threads);
+				default:	return this->graph<1,1,1,1>(graph,n,m,vertices_rand,threads);
+			}
+		}
+		//随机生成一个 n 个点 m 条边的图，图的种类由模板参数给出，例如 RandomGraph.graph<1,0,0,0>(n,m) 生成连通的简单无向图。
+		template<bool Connected,bool RepeatedEdges,bool SelfRings,bool Directional> inline std::vector<std::pair<int,int>> graph(int n,int m,bool vertices_rand=1,int threads=1){
+			std::vector<std::pair<int,int>> graph(0);
+			this->graph<Connected,RepeatedEdges,SelfRings,Directional>(graph,n,m,vertices_rand,threads);
+			return graph;
+		}
+		/*
+		随机生成一个 n 个点 m 条边的图，边追加到 graph 的末尾，图的种类由模板参数给出。
+		每种组合单独实例化：有重边时内层循环只有两次采样和一次比较，没有重边时用 RandomDistinct.sample 选出不同的边的编号再并行解码。
+		graph 不是 std::vector（例如 FEdgeFile）时，没有重边的情况改用 RandomDistinct.sample_sorted 边选边追加，不在内存中保存边的编号，
+		这时除生成树外的边按打乱编号前的字典序排列，与 graph_stream 相同。
+		*/
+		template<bool Connected,bool RepeatedEdges,bool SelfRings,bool Directional,typename G,typename=typename std::enable_if<!std::is_arithmetic<G>::value>::type> inline void graph(G &graph,int n,int m,bool vertices_rand=1,int threads=1){
+			FESDRER_STAT_CALL("RandomGraph.graph");
+			assert(check(n,m,Connected,RepeatedEdges,SelfRings,Directional));
+			const int block=1<<16;
+			EdgeCodec<SelfRings,Directional> E(n);
+			size_t st0=graph.size();
+			std::vector<long long> S(0);
+			FESDRER_STAT_PHASE(tree);
+			if(Connected){
 				std::vector<std::pair<int,int>> tree=RandomTree.random_tree(n,5,0);
-				for(std::pair<int,int> edge:tree){
-					graph.push_back(edge),m--;
-					if(directional)		S.insert(Gid(edge.first,edge.second));
-					else	S.insert(Gid(std::min(edge.first,edge.second),std::max(edge.first,edge.second)));
-				}
+				for(std::pair<int,int> edge:tree)	graph.push_back(edge),m--;
+				if(!RepeatedEdges)	for(std::pair<int,int> edge:tree)	S.push_back(E.id(edge.first,edge.second));
 			}
+			FESDRER_STAT_PHASE(edges);
+			FEngine base(rng_64());
 			if(m){
-				if(!repeated_edges){
-					long long Unum=1ll*n*(n-1)/(directional?1:2)+(self_rings?n:0)-graph.size();
-					std::vector<long long> edgenum;edgenum.clear();
-					if(Unum/m<=10.0){
-						for(int i=1;i<=n;i++)	for(int j=1;j<=n;j++){
-							if(!directional&&j<i)	continue;
-							if(!self_rings&&j==i)	continue;
-							if(S.find(Gid(i,j))!=S.end())	continue;
-							edgenum.push_back(Gid(i,j));
-						}
-						RandomBasic.random_shuffle(edgenum.begin(),edgenum.end());
-						int nownum=int(edgenum.size());
-						while(nownum>m)	edgenum.pop_back(),nownum--;
-					}
-					else{
-						while(m--){
-							int x,y;
-							while(true){
-								x=random(1,n),y=random(1,n);
-								if(!directional&&x>y)	std::swap(x,y);
-								if(!self_rings&&x==y)	(x==n?x--:y++);
-								if(S.find(Gid(x,y))==S.end())	break;
-							}
-							edgenum.push_back(Gid(x,y)),S.insert(Gid(x,y));
-						}
-					}
-					for(long long i:edgenum)	graph.push_back({Gx(i),Gy(i)});
+				size_t st=graph.size();
+				int chunk=(m+block-1)/block;
+				if(!RepeatedEdges&&!in_memory<G>::value){
+					long long row=1;
+					RandomDistinct.sample_sorted(E.U,m,[&](long long id){graph.push_back(E.edge_after(id,row));},S);
+				}
+				else if(!RepeatedEdges){
+					std::vector<long long> edgenum=RandomDistinct.sample(E.U,m,S,threads);
+					graph.resize(st+m);
+					FESDRER_STL::parallel_for(chunk,threads,[&](int c){
+						for(int i=c*block;i<std::min(m,(c+1)*block);i++)	graph[st+i]=E.edge(edgenum[i]);
+					});
 				}
 				else{
-					while(m--){
-						int x=random(1,n),y=random(1,n);
-						if(!directional&&x>y)	std::swap(x,y);
-						if(!self_rings&&x==y)	(x==n?x--:y++);
-						graph.push_back({x,y});
-					}
-				}	
+					FSampler R(1,n),Q(1,std::max(1,n-1));
+					std::vector<FEngine> eng=random_substreams(base,chunk);
+					graph.resize(st+m);
+					FESDRER_STL::parallel_for(chunk,threads,[&](int c){
+						for(int i=c*block;i<std::min(m,(c+1)*block);i++)	graph[st+i]=draw<SelfRings,Directional>(R,Q,eng[c]);
+					});
+				}
+			}
+			if(vertices_rand)	RandomGraphTool.random_vertices(n,graph.begin()+st0,graph.end(),threads);
+		}
+		/*
+		流式随机生成一个 n 个点 m 条边的图，每生成一条边 (x,y) 就调用一次 f(x,y)，不保存整个边集，额外空间只与 n 有关。
+		无重边时先给出生成树的边，其余的边按打乱编号前的字典序给出。其余参数与 graph 相同。
+		*/
+		template<typename F> inline void graph_stream(int n,int m,bool connected,bool repeated_edges,bool self_rings,bool directional,bool vertices_rand,F f){
+			switch(self_rings*2+directional){
+				case 0:	return stream<0,0>(n,m,connected,repeated_edges,vertices_rand,f);
+				case 1:	return stream<0,1>(n,m,connected,repeated_edges,vertices_rand,f);
+				case 2:	return stream<1,0>(n,m,connected,repeated_edges,vertices_rand,f);
+				default:	return stream<1,1>(n,m,connected,repeated_edges,vertices_rand,f);
 			}
-			if(vertices_rand)	RandomGraphTool.random_vertices(n,graph);
-			return graph;
 		}
 	};
 	static RANDOMGRAPH RandomGraph;
@@ -651,6 +2524,7 @@ namespace FESDRER_RAND{
 	public:
 		//随机生成一张 n 个点的图来卡 spfa，边的权值在 [l,r] 范围内，边数大约是 1.5*n。
 		inline std::vector<std::pair<std::pair<int,int>,int>> hackspfa(int n,int l,int r){
+			FESDRER_STAT_CALL("RandomHackSpfa.hackspfa");FESDRER_STAT_PHASE(edges);
 			std::vector<std::pair<std::pair<int,int>,int>> graph;graph.clear();
 			if(l<0){
 				int root=n/2;
@@ -679,6 +2553,308 @@ namespace FESDRER_RAND{
 	static RANDOMHACKSPFA RandomHackSpfa;
 
 
+	/*
+	卡时间的数据生成函数，生成的数据都可以用 RandomPrint 输出：
+	anti_hash 卡 libstdc++ 的 unordered_map，anti_dijkstra 卡用优先队列的 dijkstra，anti_qsort 卡手写的快速排序，deep_tree 卡递归。
+	*/
+	class RANDOMHACK{
+	public:
+		//McIlroy 的比较器：第一次比较到的数才确定大小，使排序做尽可能多的比较。只保存指针，可以按值传递。
+		struct Gas{
+			std::vector<int> *val;
+			int *solid,*candidate,gas;
+			inline bool operator()(int x,int y)const{
+				std::vector<int> &v=*val;
+				if(v[x]==gas&&v[y]==gas){
+					if(x==*candidate)	v[x]=(*solid)++;
+					else	v[y]=(*solid)++;
+				}
+				if(v[x]==gas)	*candidate=x;
+				else if(v[y]==gas)	*candidate=y;
+				return v[x]<v[y];
+			}
+		};
+	private:
+		//libstdc++ 的 unordered_map 插入时依次使用的桶数。
+		static const std::vector<long long>& bucket_primes(){
+			static const std::vector<long long> p{13,29,59,127,257,541,1109,2357,5087,10273,20753,42043,85229,172933,351061,712697,1447153,2938679,5967347,12117689,24607243,49969847};
+			return p;
+		}
+		//常见的以中间元素为基准的快速排序，用栈代替递归，比较的顺序与递归的写法相同。
+		static void mid_qsort(int *a,int *last,Gas cmp){
+			std::vector<std::pair<int,int>> st(1,{0,int(last-a)-1});
+			while(st.size()){
+				int l=st.back().first,r=st.back().second;st.pop_back();
+				int i=l,j=r,mid=a[(l+r)>>1];
+				while(i<=j){
+					while(cmp(a[i],mid))	i++;
+					while(cmp(mid,a[j]))	j--;
+					if(i<=j)	std::swap(a[i],a[j]),i++,j--;
+				}
+				if(i<r)	st.push_back({i,r});
+				if(l<j)	st.push_back({l,j});
+			}
+		}
+	public:
+		/*
+		生成 n 个 [1,V] 中不同的整数，依次插入 unordered_map<long long,...> 或 unordered_set 时让尽可能多的数落在同一个桶里。
+		桶数为 p 时 p 的倍数都在 0 号桶，插入第 i 个数时的桶数是固定的，所以选一个桶数 p，把 p 的倍数放在桶数为 p 的那一段插入，
+		p 在 V 和 n 的限制下使这一段的比较次数最多。其余的数不是 p 的倍数，随机选取。
+		*/
+		inline std::vector<long long> anti_hash(int n,long long V=1000000000){
+			FESDRER_STAT_CALL("RandomHack.anti_hash");FESDRER_STAT_PHASE(edges);
+			const std::vector<long long> &P=bucket_primes();
+			long long p=P[0],e=0,k=0;
+			double best=-1;
+			for(size_t j=0;j<P.size();j++){
+				long long lo=j?P[j-1]:0,ej=std::min((long long)n,P[j]),kj=std::min(ej,V/P[j]);
+				if(lo>=n)	break;
+				if(kj<=0||n-kj>V-V/P[j])	continue;
+				double c=double(ej-std::max(lo+1,ej-kj+1)+1),cost=c*(kj-c)+c*(c-1)/2;
+				if(cost>=best)	best=cost,p=P[j],e=ej,k=kj;
+			}
+			assert(best>=0);
+			std::vector<long long> ret(std::max(n,0)),hit=RandomDistinct.sample(V/p,k),other=RandomDistinct.sample(V-V/p,n-k);
+			for(long long i=0,h=0,o=0;i<n;i++){
+				if(i>=e-k&&i<e)	ret[i]=(hit[h++]+1)*p;
+				else	ret[i]=other[o]+1+other[o]/(p-1),o++;
+			}
+			return ret;
+		}
+		/*
+		随机生成一张 n 个点 m 条边的有向图卡 dijkstra，起点为 1，边为 {{u,v},w}，m 在 [n-1,(n-1)+(n-1)(n-2)/2]。
+		有一条权值在 [1,r] 的链 1->...->n 决定最短路，按链上的顺序出队；其余的边 u->v 都跨过至少一个点，
+		每条都在 u 出队时让 v 的距离变小而入队一次，且比 v 的最短路长，所以优先队列中始终有 O(m) 个元素。当作无向图也一样。
+		*/
+		inline std::vector<std::pair<std::pair<int,int>,int>> anti_dijkstra(int n,int m,int r=1){
+			FESDRER_STAT_CALL("RandomHack.anti_dijkstra");FESDRER_STAT_PHASE(edges);
+			long long extra=(long long)(n-1)*(n-2)/2;
+			assert(n>=2&&m>=n-1&&m-(n-1)<=extra&&r>=1&&(long long)r*n+n<INT_MAX);
+			std::vector<long long> d(n+1,0);
+			std::vector<std::pair<std::pair<int,int>,int>> graph(0);
+			graph.reserve(m);
+			for(int i=1;i<n;i++){
+				int w=int(random(1,r));
+				graph.push_back({{i,i+1},w}),d[i+1]=d[i]+w;
+			}
+			long long T=d[n]+n+1;
+			for(long long c:RandomDistinct.sample(extra,m-(n-1))){
+				std::pair<long long,long long> e=FESDRER_STL::triangle_pair(c);
+				int i=int(e.first)+1,j=int(e.second)+2;
+				graph.push_back({{i,j},int(T-i-d[i])});
+			}
+			RandomGraphTool.random_vertices(n,graph);
+			RandomBasic.random_shuffle(graph.begin(),graph.end());
+			return graph;
+		}
+		/*
+		生成一个 1 到 n 的排列，用 sort(a,a+n,cmp) 排序时比较次数尽可能多（McIlroy 的方法）。
+		sort(int *first,int *last,Gas cmp) 是要卡的排序，用 cmp 比较，时间与它在结果上运行的时间相同。
+		*/
+		template<typename S> inline std::vector<int> anti_qsort(int n,S sort){
+			FESDRER_STAT_CALL("RandomHack.anti_qsort");FESDRER_STAT_PHASE(edges);
+			std::vector<int> val(std::max(n,0),n),a(std::max(n,0));
+			int solid=0,candidate=-1;
+			for(int i=0;i<n;i++)	a[i]=i;
+			if(n)	sort(&a[0],&a[0]+n,Gas{&val,&solid,&candidate,n});
+			for(int &v:val)	v=(v==n?solid++:v)+1;
+			return val;
+		}
+		//生成一个 1 到 n 的排列卡常见的以 a[(l+r)/2] 为基准的快速排序，比较次数为 O(n^2)，递归深度为 O(n)。
+		inline std::vector<int> anti_qsort(int n){
+			return anti_qsort(n,mid_qsort);
+		}
+		/*
+		生成一个 n 个点、以 1 为根、深度为 h 的扫帚形的树，h 在 [n>1,n-1]，返回父亲数组。
+		1 向下是一条长为 h 的链，其余的点都挂在链上深度为 h-1 的点下面，从任何一个点出发 dfs 的深度都至少为 h/2。
+		*/
+		inline std::vector<int> deep_tree(int n,int h,bool vertices_rand=1){
+			FESDRER_STAT_CALL("RandomHack.deep_tree");FESDRER_STAT_PHASE(tree);
+			assert(n>=1&&h>=(n>1)&&h<=n-1);
+			std::vector<int> fa(n+1,0),id(n+1);
+			for(int i=0;i<=n;i++)	id[i]=i;
+			if(vertices_rand)	RandomBasic.random_shuffle(id.begin()+std::min(n+1,2),id.end());
+			for(int i=2;i<=n;i++)	fa[id[i]]=id[i<=h+1?i-1:h];
+			return fa;
+		}
+	};
+	static RANDOMHACK RandomHack;
+
+
+	/*
+	卡网络流和二分图匹配的数据生成函数。网络流的源点为 1，汇点为 n，边为 {{u,v},容量}，三种数据都有 check 和 nm，用 type 区分：
+	DINIC 卡 dinic 的增广轮数；PUSH_RELABEL 仿照 Cherkassky 和 Goldberg 的 AK 网络，同时卡 dinic 和带 gap 优化的预流推进（HLPP）；MATCHING 卡 Hopcroft-Karp。
+	*/
+	class RANDOMFLOW{
+	public:
+		enum Type{DINIC,PUSH_RELABEL,MATCHING};
+	private:
+		//PUSH_RELABEL 三部分的点数：卡 dinic 的链 k1 个点，把多余的流退回源点的链 k2 个点，标尺 q 个点。
+		static inline void split(int n,int &k1,int &k2,int &q){
+			k1=(n-2)/3,k2=(n-2-k1)/2,q=n-2-k1-k2;
+		}
+		//MATCHING 中有 L+1 个小块，第 i 个小块的左部有 i+1 个点，小块的左部点数之和不超过 n/2。
+		static inline int blocks(int n){
+			int L=0;
+			while(1ll*(L+2)*(L+3)/2<=n/2)	L++;
+			return L;
+		}
+		/*
+		从 1 进入一条 k 个点的链 a,a+1,...,a+k-1，链上每个点都有一条容量在 [l,r] 中的边到汇点 n，链上的容量恰好等于后面流出的总量。
+		第 i 轮 dinic 的最短路长为 i+1，只能流满一条到汇点的边，所以要 k 轮。再加 extra 条在链上向回的边，不产生更短的路，只让每轮 bfs 变慢。
+		*/
+		template<typename G> inline void ladder(G &graph,int n,int a,int k,int l,int r,long long extra){
+			std::vector<int> c(k);
+			long long sum=0;
+			for(int i=0;i<k;i++)	c[i]=int(random(l,r)),sum+=c[i];
+			graph.push_back({{1,a},int(sum)});
+			for(int i=0;i<k;i++){
+				graph.push_back({{a+i,n},c[i]}),sum-=c[i];
+				if(i+1<k)	graph.push_back({{a+i,a+i+1},int(sum)});
+			}
+			for(long long id:RandomDistinct.sample(1ll*k*(k-1)/2,extra)){
+				std::pair<long long,long long> e=FESDRER_STL::triangle_pair(id);
+				graph.push_back({{a+int(e.second),a+int(e.first)},int(random(l,r))});
+			}
+		}
+	public:
+		//type 类的数据中 n 个点最少和最多有多少条边，MATCHING 的 n 为每一部的点数。check 和 nm 都用它们。
+		static inline long long min_edges(int n,Type type){
+			if(type==DINIC)	return 2ll*(n-2);
+			if(type==PUSH_RELABEL){
+				int k1,k2,q;
+				split(n,k1,k2,q);
+				return 2ll*k1+k2+q+2;
+			}
+			long long L=blocks(n),G=(L+1)*(L+2)/2;
+			return (L+1)*(L+1)+(n-G)+L;
+		}
+		static inline long long max_edges(int n,Type type){
+			if(type==DINIC)	return min_edges(n,type)+1ll*(n-2)*(n-3)/2;
+			if(type==PUSH_RELABEL){
+				int k1,k2,q;
+				split(n,k1,k2,q);
+				return min_edges(n,type)+1ll*k1*(k1-1)/2;
+			}
+			long long L=blocks(n),G=(L+1)*(L+2)/2,p=n-G;
+			return (L+1)*(L+1)+p+p*(p-1)+(G-L-1)*p;
+		}
+		//检查点数 n 和边数 m 是否合法，DINIC 要求 n>=3，PUSH_RELABEL 要求 n>=5，MATCHING 要求 n>=1。
+		inline bool check(int n,int m,Type type){
+			bool ret=n>=(type==DINIC?3:type==PUSH_RELABEL?5:1)&&m>=min_edges(n,type)&&m<=max_edges(n,type);
+			if(!ret)	std::cerr<<"Error: "<<n<<" "<<m<<" "<<type<<'\n';
+			return ret;
+		}
+		/*
+		生成一个点数不超过 N，边数不超过 M 的点数和边数，以 {点数，边数} 的形式返回。注意 N 应大于等于 5。
+		opt 在 [0,+infinity]，其越大，生成的点数边数越接近 N 和 M。
+		*/
+		inline std::vector<int> nm(int N,int M,Type type,double opt=1){
+			if(N<5)	return std::vector<int>{-1,-1};
+			int n=random(5,N,opt);
+			long long Ml=min_edges(n,type),Mr=std::min<long long>(M,max_edges(n,type));
+			if(Ml>Mr)	return {-1,-1};
+			int m=random(Ml,Mr,opt);
+			return std::vector<int>{n,m};
+		}
+		/*
+		随机生成一个 n 个点 m 条边的网络卡 dinic，到汇点的边的容量在 [l,r] 中，要求 r*(n-2) 不超过 int 的范围。
+		dinic 要增广 n-2 轮，每轮 bfs 都要访问所有的边。
+		*/
+		inline std::vector<std::pair<std::pair<int,int>,int>> dinic(int n,int m,int l,int r){
+			FESDRER_STAT_CALL("RandomFlow.dinic");FESDRER_STAT_PHASE(edges);
+			assert(check(n,m,DINIC)&&l>=1&&l<=r&&1ll*r*(n-2)<=INT_MAX);
+			std::vector<std::pair<std::pair<int,int>,int>> graph(0);
+			graph.reserve(m);
+			ladder(graph,n,2,n-2,l,r,m-min_edges(n,DINIC));
+			RandomGraphTool.random_vertices(n,graph);
+			RandomBasic.random_shuffle(graph.begin(),graph.end());
+			return graph;
+		}
+		/*
+		随机生成一个 n 个点 m 条边的网络卡预流推进，容量在 [l,r] 中，要求 l<r，r*n/3 不超过 int 的范围。
+		由三部分组成：一条卡 dinic 的链（与 dinic() 相同，多余的边也加在这里）；
+		一条容量为 r 的长链，末端只有容量为 l 的边到汇点，多余的 r-l 的流要沿着链一格一格地抬高标号退回源点；
+		一条到汇点的容量为 1 的标尺链，占住 [1,q] 的每个标号，使 gap 优化不起作用。HLPP 要做 O(n^2) 次重标号。
+		*/
+		inline std::vector<std::pair<std::pair<int,int>,int>> push_relabel(int n,int m,int l,int r){
+			FESDRER_STAT_CALL("RandomFlow.push_relabel");FESDRER_STAT_PHASE(edges);
+			int k1,k2,q;
+			split(n,k1,k2,q);
+			assert(check(n,m,PUSH_RELABEL)&&l>=1&&l<r&&1ll*r*k1<=INT_MAX);
+			std::vector<std::pair<std::pair<int,int>,int>> graph(0);
+			graph.reserve(m);
+			ladder(graph,n,2,k1,l,r,m-min_edges(n,PUSH_RELABEL));
+			int b=2+k1,p=b+k2;
+			graph.push_back({{1,b},r});
+			for(int i=b;i<b+k2-1;i++)	graph.push_back({{i,i+1},r});
+			graph.push_back({{b+k2-1,n},l});
+			graph.push_back({{1,p},1});
+			for(int i=p;i<p+q-1;i++)	graph.push_back({{i,i+1},1});
+			graph.push_back({{p+q-1,n},1});
+			RandomGraphTool.random_vertices(n,graph);
+			RandomBasic.random_shuffle(graph.begin(),graph.end());
+			return graph;
+		}
+		/*
+		随机生成一个左右各 n 个点、m 条边的二分图卡 Hopcroft-Karp，边为 {左部点,右部点}。
+		第 i 个小块是一条长为 2i+1 的路，按编号从小到大、每个点按边的输入顺序找第一轮的极大匹配时，路上的点都匹配到“错”的一边，
+		增广路的长度为 2i+1，每轮只沿最短的增广路增广时要在第 i+1 轮才能找到，共 O(sqrt(n)) 轮。其余的点是一个完美匹配加上随机的边，只和小块的左部点相连，
+		每一轮 bfs 都会访问到它们，但不产生更短的增广路。用链式前向星存图时边的顺序是反的，star=1 时把边倒序输出。
+		只卡只沿最短增广路增广的写法：bfs 记下最近的未匹配右部点所在的层，dfs 只在这一层接受未匹配的右部点（n=1e5,m=1e6 时 315 轮）。
+		常见的写法 if(!mr[v]||(dist[mr[v]]==dist[u]+1&&dfs(mr[v]))) 在任何一层都接受未匹配点，第二轮就把所有小块一起增广，只要 2 轮，卡不住。
+		*/
+		inline std::vector<std::pair<int,int>> matching(int n,int m,bool star=0){
+			FESDRER_STAT_CALL("RandomFlow.matching");FESDRER_STAT_PHASE(edges);
+			assert(check(n,m,MATCHING));
+			int L=blocks(n),G=(L+1)*(L+2)/2,p=n-G,cntx=G-L-1;
+			std::vector<int> left(n+1),right(n+1),head(L+1),x(0);
+			for(int i=0;i<=n;i++)	left[i]=right[i]=i;
+			RandomBasic.random_shuffle(left.begin()+1,left.end()-(L+1));
+			RandomBasic.random_shuffle(right.begin()+1,right.end());
+			std::vector<std::pair<int,int>> first(0),rest(0);
+			first.reserve(n),rest.reserve(m-n),x.reserve(cntx);
+			//小块的左部点 x_0..x_i，右部点 y_0..y_i，x_0 的编号最大，最后才找匹配。
+			for(int i=0,lid=0,rid=0;i<=L;i++){
+				int x0=n-L+i,y0=rid;
+				first.push_back({x0,y0});
+				for(int j=1;j<=i;j++){
+					first.push_back({lid+1,y0+j-1}),rest.push_back({lid+1,y0+j});
+					x.push_back(++lid);
+				}
+				rid+=i+1;
+				if(i)	head[i]=lid-i;
+			}
+			//填充部分的左部点为 f_0..f_{p-1}（编号 G-L..n-L-1），右部点为 g_0..g_{p-1}（编号 G..n-1），f_t 的第一条边连 g_t。
+			for(int t=0;t<p;t++)	first.push_back({cntx+1+t,G+t});
+			std::vector<long long> ex(0);
+			for(int i=1;i<=L;i++){
+				int j=head[i]+int(random_bounded(i)),g=int(random_bounded(p));
+				ex.push_back(1ll*p*(p-1)+1ll*j*p+g);
+			}
+			std::vector<long long> pick=RandomDistinct.sample(1ll*p*(p-1)+1ll*cntx*p,m-min_edges(n,MATCHING),ex);
+			pick.insert(pick.end(),ex.begin(),ex.end());
+			for(long long c:pick){
+				if(c<1ll*p*(p-1)){
+					int f=int(c/(p-1)),g=int(c%(p-1));
+					rest.push_back({cntx+1+f,G+g+(g>=f)});
+				}
+				else{
+					c-=1ll*p*(p-1);
+					rest.push_back({x[c/p],G+int(c%p)});
+				}
+			}
+			RandomBasic.random_shuffle(first.begin(),first.end());
+			RandomBasic.random_shuffle(rest.begin(),rest.end());
+			first.insert(first.end(),rest.begin(),rest.end());
+			for(std::pair<int,int> &e:first)	e=std::make_pair(left[e.first],right[e.second+1]);
+			if(star)	std::reverse(first.begin(),first.end());
+			return first;
+		}
+	};
+	static RANDOMFLOW RandomFlow;
+
+
 	//有向无环连通图生成函数。
 	class RANDOMDAG{
 	public:
@@ -711,7 +2887,7 @@ namespace FESDRER_RAND{
 			for(int i:degree)	fdegree.push_back(i);
 			int sum=0;
 			for(int i=1;i<n;i++){
-				int l=i-1,r=fdegree.lower_bound(i-sum)-1;
+				int l=i-1,r=std::max(l,fdegree.lower_bound(i-sum)-1);
 				int id=random(l,r),num=fdegree[l];
 				sum+=fdegree[id];
 				if(id>l){
@@ -729,11 +2905,10 @@ namespace FESDRER_RAND{
 			for(int i=0;i<n-1;i++)	if(!degree[i])	nodegree[i]++;
 			return make_pair(degree,nodegree);
 		}
-		inline std::vector<std::pair<int,int>> singlest_dag(int n,int m){
+		template<typename G> inline void singlest_dag(G &graph,int n,int m){
 			std::pair<std::vector<int>,std::vector<int>> degree=outdegree(n,m);
 			FESDRER_STL::FVector end(1,1);
 			std::vector<int> noend(0);
-			std::vector<std::pair<int,int>> graph(0);
 			for(int i=2;i<=n;i++){
 				int endde=degree.first[i-2],node=degree.second[i-2],id;
 				while(endde--){
@@ -748,18 +2923,24 @@ namespace FESDRER_RAND{
 				}
 				end.push_back(i);
 			}
-			return graph;
 		}
 	public:
 		//随机生成一个 n 个点 m 条边的 dag，single_s 和 single_t 控制是否只有一个源点和汇点。若只有一个源点则其为 1，若只有一个汇点则其为 n。
 		inline std::vector<std::pair<int,int>> dag(int n,int m,bool single_s,bool single_t){
+			std::vector<std::pair<int,int>> graph(0);
+			dag(graph,n,m,single_s,single_t);
+			return graph;
+		}
+		//随机生成一个 n 个点 m 条边的 dag，边追加到 graph 的末尾，参数与上面相同。
+		template<typename G,typename=typename std::enable_if<!std::is_arithmetic<G>::value>::type> inline void dag(G &graph,int n,int m,bool single_s,bool single_t){
+			FESDRER_STAT_CALL("RandomDag.dag");FESDRER_STAT_PHASE(tree);
 			assert(check(n,m));
-			if(n==1)	return std::vector<std::pair<int,int>>(0);
-			bool if_reverse;
+			if(n==1)	return;
+			bool if_reverse=0;
 			if(single_t&&!single_s)	if_reverse=1,std::swap(single_s,single_t);
-			std::vector<std::pair<int,int>> graph(0);
-			if(single_s&&!single_t)	graph=RandomGraph.graph(n,m,1,1,0,0);
-			else if(single_s&&single_t)	graph=singlest_dag(n,m);
+			size_t st=graph.size();
+			if(single_s&&!single_t)	RandomGraph.graph(graph,n,m,1,1,0,0);
+			else if(single_s&&single_t)	singlest_dag(graph,n,m);
 			else{
 				std::vector<std::vector<int>> e=RandomGraphTool.get_outedge(n,RandomTree.random_tree(n,5),0);
 				std::vector<int> start=RandomAnother.random_different(1,n,random(1,n,0.3)),vis(n,0),topo(0);
@@ -773,6 +2954,7 @@ namespace FESDRER_RAND{
 					for(int y:e[x-1])	if(!vis[y-1])	graph.push_back({x,y}),q.push(y);
 				}
 				assert(topo.size()==n);
+				FESDRER_STAT_PHASE(edges);
 				for(int i=n;i<=m;i++){
 					int s=random(1,n),t=random(1,n);
 					if(s>t)	std::swap(s,t);
@@ -780,12 +2962,12 @@ namespace FESDRER_RAND{
 					graph.push_back({topo[s-1],topo[t-1]});
 				}
 			}
-			RandomGraphTool.random_vertices(n,graph);
-			if(if_reverse)	for(std::pair<int,int> &it:graph){
+			RandomGraphTool.random_vertices(n,graph.begin()+st,graph.end());
+			if(if_reverse)	for(size_t i=st;i<graph.size();i++){
+				std::pair<int,int> &it=graph[i];
 				it.first=n+1-it.first,it.second=n+1-it.second;
 				std::swap(it.first,it.second);
 			}
-			return graph;
 		}
 	};
 	static RANDOMDAG RandomDag;
@@ -827,11 +3009,21 @@ namespace FESDRER_RAND{
 		缩点完后的图为调入的 dag。
 		rho 在 [0,+infinity]，表示强连通分量的稠密度。其越大，强连通分量就有越多的环。
 		*/
-		inline std::vector<std::pair<int,int>> scc(int n,int m,int sccn,int sccm,std::vector<std::pair<int,int>> dag,double rho=1){
+		inline std::vector<std::pair<int,int>> scc(int n,int m,int sccn,int sccm,const std::vector<std::pair<int,int>> &dag,double rho=1){
+			std::vector<std::pair<int,int>> graph(0);
+			scc(graph,n,m,sccn,sccm,dag,rho);
+			return graph;
+		}
+		//随机生成一个 n 个点 m 条边 sccn 个强连通分量和 sccm 个缩点后的边的连通有向图，边追加到 graph 的末尾，参数与上面相同。
+		template<typename G,typename=typename std::enable_if<!std::is_arithmetic<G>::value>::type> inline void scc(G &graph,int n,int m,int sccn,int sccm,const std::vector<std::pair<int,int>> &dag,double rho=1){
+			FESDRER_STAT_CALL("RandomScc.scc");FESDRER_STAT_PHASE(tree);
 			assert(check(n,m,sccn,sccm));
 			assert(int(dag.size())==sccm);
 			int simgle_num=std::max(0,std::max(2*sccn-n,n-(m-sccm)));
-			if(simgle_num==n)	return dag;
+			if(simgle_num==n){
+				for(const std::pair<int,int> &i:dag)	graph.push_back(i);
+				return;
+			}
 			std::vector<std::vector<int>> scc=RandomAnother.random_divide(1,n-simgle_num,sccn-simgle_num),basescc(0);
 			std::vector<int> simgle_id;simgle_id.clear();
 			for(int i=n;i>n-simgle_num;i--)	simgle_id.push_back(i);
@@ -842,7 +3034,8 @@ namespace FESDRER_RAND{
 			}
 			scc=basescc;
 			std::vector<int> edgen=RandomAnother.random_divide_num(m-sccm-n+sccn,sccn-simgle_num);
-			std::vector<std::pair<int,int>> graph;graph.clear();
+			FESDRER_STAT_PHASE(edges);
+			size_t st=graph.size();
 			auto Get=[&](const std::vector<int> &vec){return vec[random(0,vec.size()-1)];};
 			for(int i=0;i<sccn-simgle_num;i++){
 				std::vector<int> &vertex=scc[i];
@@ -857,23 +3050,22 @@ namespace FESDRER_RAND{
 				graph.push_back({vertex[top],vertex[0]}),edgenum--;
 				while(top<vernum-1){
 					int newtop=(cnt==1?vernum-1:random(top+1,vernum-1,rho));
-					int st=vertex[random(0,top)],ed=vertex[random(0,top)];
+					int u=vertex[random(0,top)],v=vertex[random(0,top)];
 					cnt--;
-					graph.push_back({st,vertex[top+1]}),edgenum--;
+					graph.push_back({u,vertex[top+1]}),edgenum--;
 					for(int i=top+2;i<=newtop;i++)	graph.push_back({vertex[i-1],vertex[i]}),edgenum--;
-					graph.push_back({vertex[newtop],ed}),edgenum--;
+					graph.push_back({vertex[newtop],v}),edgenum--;
 					top=newtop;
 				}
 				while(edgenum--){
-					int st=Get(vertex),ed=Get(vertex);
-					while(st==ed)	ed=Get(vertex);
-					graph.push_back({st,ed});
+					int u=Get(vertex),v=Get(vertex);
+					while(u==v)	v=Get(vertex),FESDRER_STAT_ADD(retries,1);
+					graph.push_back({u,v});
 				}
 			}
 			for(int i:simgle_id)	scc.push_back(std::vector<int>{i});
-			for(std::pair<int,int> i:dag)	graph.push_back({Get(scc[i.first-1]),Get(scc[i.second-1])});
-			RandomGraphTool.random_vertices(n,graph);
-			return graph;
+			for(const std::pair<int,int> &i:dag)	graph.push_back({Get(scc[i.first-1]),Get(scc[i.second-1])});
+			RandomGraphTool.random_vertices(n,graph.begin()+st,graph.end());
 		}
 	};
 	static RANDOMSCC RandomScc;
@@ -902,9 +3094,14 @@ namespace FESDRER_RAND{
 		随机生成一个 n 个点 m 条边 edccn 个边双连通分量的连通无向图。
 		rho 在 [0,+infinity]，表示边双连通分量的稠密度。其越大，边双连通分量就有越多的环。
 		*/
-		inline std::vector<std::pair<int,int>> edcc(int n,int m,int edccn,std::vector<std::pair<int,int>> tree,double rho=1){
+		inline std::vector<std::pair<int,int>> edcc(int n,int m,int edccn,const std::vector<std::pair<int,int>> &tree,double rho=1){
 			return RandomScc.scc(n,m,edccn,edccn-1,tree,rho);
 		}
+		//随机生成一个 n 个点 m 条边 edccn 个边双连通分量的连通无向图，边追加到 graph 的末尾，参数与上面相同。
+		template<typename G,typename=typename std::enable_if<!std::is_arithmetic<G>::value>::type> inline void edcc(G &graph,int n,int m,int edccn,const std::vector<std::pair<int,int>> &tree,double rho=1){
+			FESDRER_STAT_CALL("RandomEdcc.edcc");FESDRER_STAT_PHASE(tree);
+			RandomScc.scc(graph,n,m,edccn,edccn-1,tree,rho);
+		}
 	};
 	static RANDOMEDCC RandomEdcc;
 
@@ -973,13 +3170,21 @@ namespace FESDRER_RAND{
 		rho 在 [0,+infinity]，表示点双连通分量的稠密度。其越大，点双连通分量就有越多的环。
 		*/
 		inline std::vector<std::pair<int,int>> vdcc(int n,int m,int vdccn,double rho=1){
+			std::vector<std::pair<int,int>> graph(0);
+			vdcc(graph,n,m,vdccn,rho);
+			return graph;
+		}
+		//随机生成一个 n 个点 m 条边 vdccn 个点双连通分量的连通无向图，边追加到 graph 的末尾，参数与上面相同。
+		template<typename G,typename=typename std::enable_if<!std::is_arithmetic<G>::value>::type> inline void vdcc(G &graph,int n,int m,int vdccn,double rho=1){
+			FESDRER_STAT_CALL("RandomVdcc.vdcc");FESDRER_STAT_PHASE(tree);
 			assert(check(n,m,vdccn));
-			if(n==1)	return std::vector<std::pair<int,int>>(0);
+			if(n==1)	return;
 			std::vector<std::vector<int>> vdcc=vdcc_spread(n,m,vdccn);
 			int sum=0;
-			for(std::vector<int> i:vdcc)	sum+=(int(i.size())==2?1:int(i.size()));
+			for(const std::vector<int> &i:vdcc)	sum+=(int(i.size())==2?1:int(i.size()));
 			std::vector<int> edgen=RandomAnother.random_divide_num(m-sum+vdccn,vdccn);
-			std::vector<std::pair<int,int>> graph(0);
+			FESDRER_STAT_PHASE(edges);
+			size_t st=graph.size();
 			for(int i=0;i<vdccn;i++){
 				std::vector<int> &vertex=vdcc[i];
 				int vernum=int(vertex.size()),edgenum=edgen[i]+(vernum==2?1:vernum)-1;
@@ -993,23 +3198,22 @@ namespace FESDRER_RAND{
 				graph.push_back({vertex[top],vertex[0]}),edgenum--;
 				while(top<vernum-1){
 					int newtop=(cnt==1?vernum-1:random(top+1,vernum-1,rho));
-					int st=vertex[random(0,top)],ed=vertex[random(0,top)];
-					while(st==ed)	ed=vertex[random(0,top)];
+					int u=vertex[random(0,top)],v=vertex[random(0,top)];
+					while(u==v)	v=vertex[random(0,top)],FESDRER_STAT_ADD(retries,1);
 					cnt--;
-					graph.push_back({st,vertex[top+1]}),edgenum--;
+					graph.push_back({u,vertex[top+1]}),edgenum--;
 					for(int i=top+2;i<=newtop;i++)	graph.push_back({vertex[i-1],vertex[i]}),edgenum--;
-					graph.push_back({vertex[newtop],ed}),edgenum--;
+					graph.push_back({vertex[newtop],v}),edgenum--;
 					top=newtop;
 				}
 				auto Get=[&](const std::vector<int> &vec){return vec[random(0,vec.size()-1)];};
 				while(edgenum--){
-					int st=Get(vertex),ed=Get(vertex);
-					while(st==ed)	ed=Get(vertex);
-					graph.push_back({st,ed});
+					int u=Get(vertex),v=Get(vertex);
+					while(u==v)	v=Get(vertex),FESDRER_STAT_ADD(retries,1);
+					graph.push_back({u,v});
 				}
 			}
-			RandomGraphTool.random_vertices(n,graph);
-			return graph;
+			RandomGraphTool.random_vertices(n,graph.begin()+st,graph.end());
 		}
 	};
 	static RANDOMVDCC RandomVdcc;
@@ -1017,29 +3221,157 @@ namespace FESDRER_RAND{
 
 
 namespace FESDRER_CHECK{
-	class CHECKTREE{
-	private:
-		inline void dep_dfs(int x,int fas,std::vector<std::vector<int>> &e,std::vector<int> &dep){
-			if(x!=1)	dep[x-1]=dep[fas-1]+1;
-			for(int y:e[x])	if(y!=fas)	dep_dfs(y,x,e,dep);
+	/*
+	下面的检查函数都先把边的数组转成 FESDRER_STL::FGraph，再用非递归的 dfs/bfs 求解，不会因为图很深而爆栈。
+	每个检查函数的临时数组都从一整块 arena 中切出来，只申请一次内存。
+	threads 大于 1 时改用并行算法，求出的连通分量与单线程时相同，只是分量之间、分量内点的顺序可能不同。
+	*/
+	//并行检查用到的工具。
+	class CHECKTOOL{
+	public:
+		enum{GRAIN=1<<12};
+		//对 i=0,1,...,n-1 执行 f(i)，每 GRAIN 个分成一段交给 threads 个线程，只有一段时直接在当前线程执行。
+		template<typename F> inline void each(int n,int threads,F f){
+			int parts=(n+GRAIN-1)/GRAIN;
+			if(threads<=1||parts<=1){
+				for(int i=0;i<n;i++)	f(i);
+				return;
+			}
+			FESDRER_STL::parallel_for(parts,threads,[&](int c){
+				for(int i=c*GRAIN,r=std::min(n,(c+1)*GRAIN);i<r;i++)	f(i);
+			});
+		}
+		//对 i=0,1,...,n-1 执行 f(i,out)，把 f 加入 out 的数按 i 的顺序接在 ret 的末尾，结果与线程数无关。
+		template<typename F> inline void gather(int n,int threads,std::vector<int> &ret,F f){
+			int parts=(n+GRAIN-1)/GRAIN;
+			if(threads<=1||parts<=1){
+				for(int i=0;i<n;i++)	f(i,ret);
+				return;
+			}
+			std::vector<std::vector<int>> part(parts);
+			FESDRER_STL::parallel_for(parts,threads,[&](int c){
+				for(int i=c*GRAIN,r=std::min(n,(c+1)*GRAIN);i<r;i++)	f(i,part[c]);
+			});
+			for(std::vector<int> &it:part)	ret.insert(ret.end(),it.begin(),it.end());
+		}
+		//bfs 扩展一层：对 now 中每个点 x 的每条出边 i（终点为 y），若 f(x,y,i) 为真就把 y 加入 next。f 要保证每个点只返回一次真。
+		template<typename F> inline void expand(const FESDRER_STL::FGraph &g,const std::vector<int> &now,std::vector<int> &next,int threads,F f){
+			next.clear();
+			gather(int(now.size()),threads,next,[&](int k,std::vector<int> &out){
+				int x=now[k];
+				for(int i=g.fst[x];i<g.fst[x+1];i++)	if(f(x,g.to[i],i))	out.push_back(g.to[i]);
+			});
+		}
+		//给 a 打上标记 bit，若之前没有这个标记则返回真，多个线程同时打同一个标记时只有一个返回真。
+		inline bool claim(std::atomic<unsigned char> &a,unsigned char bit){
+			return !(a.fetch_or(bit,std::memory_order_relaxed)&bit);
+		}
+	};
+	static CHECKTOOL CheckTool;
+
+
+	/*
+	无向图的 bfs 生成森林，用于并行求桥和点双（Tarjan-Vishkin 算法）。
+	fa、pe 为父亲和连向父亲的边在原数组中的下标，siz 为子树大小，pre 为先序编号，
+	low、high 为子树中的点以及它们经过非树边能到的点中先序编号的最小值和最大值。
+	order 为所有点的 bfs 序，level 为每一层在 order 中的起点，同一个点的儿子在 order 中连续存放，从 son[x] 开始。
+	*/
+	class FOREST{
+	public:
+		std::vector<int> fa,pe,son,siz,pre,low,high,order,level;
+		FOREST(const FESDRER_STL::FGraph &g,int threads){
+			int n=g.size();
+			fa.assign(n+1,0),pe.assign(n+1,-1),son.assign(n+1,0),siz.assign(n+1,1),pre.assign(n+1,0),low.assign(n+1,0),high.assign(n+1,0);
+			order.reserve(n);
+			std::vector<std::atomic<unsigned char>> vis(n+1);
+			CheckTool.each(n+1,threads,[&](int x){vis[x].store(0,std::memory_order_relaxed);});
+			std::vector<int> now(0),next(0);
+			for(int s=1;s<=n;s++)	if(CheckTool.claim(vis[s],1)){
+				now.assign(1,s);
+				while(now.size()){
+					int base=int(order.size()+now.size());
+					level.push_back(int(order.size()));
+					order.insert(order.end(),now.begin(),now.end());
+					CheckTool.expand(g,now,next,threads,[&](int x,int y,int i){
+						if(!CheckTool.claim(vis[y],1))	return false;
+						fa[y]=x,pe[y]=g.eid[i];
+						return true;
+					});
+					CheckTool.each(int(next.size()),threads,[&](int k){
+						if(!k||fa[next[k-1]]!=fa[next[k]])	son[fa[next[k]]]=base+k;
+					});
+					now.swap(next);
+				}
+			}
+			level.push_back(n);
+			auto children=[&](int x,int &l,int &r){
+				l=r=son[x];
+				while(r<n&&fa[order[r]]==x)	r++;
+			};
+			for(int d=int(level.size())-2;d>=0;d--)	CheckTool.each(level[d+1]-level[d],threads,[&](int k){
+				int x=order[level[d]+k],l,r;
+				children(x,l,r);
+				for(int j=l;j<r;j++)	siz[x]+=siz[order[j]];
+			});
+			int tot=0;
+			for(int d=0;d+1<int(level.size());d++)	if(!fa[order[level[d]]])	pre[order[level[d]]]=tot,tot+=siz[order[level[d]]];
+			for(int d=0;d+1<int(level.size());d++)	CheckTool.each(level[d+1]-level[d],threads,[&](int k){
+				int x=order[level[d]+k],l,r,cnt=pre[x]+1;
+				children(x,l,r);
+				for(int j=l;j<r;j++)	pre[order[j]]=cnt,cnt+=siz[order[j]];
+			});
+			for(int d=int(level.size())-2;d>=0;d--)	CheckTool.each(level[d+1]-level[d],threads,[&](int k){
+				int x=order[level[d]+k],lo=pre[x],hi=pre[x];
+				for(int i=g.fst[x];i<g.fst[x+1];i++){
+					int y=g.to[i],e=g.eid[i];
+					if(e==pe[x])	continue;
+					if(fa[y]==x&&pe[y]==e)	lo=std::min(lo,low[y]),hi=std::max(hi,high[y]);
+					else	lo=std::min(lo,pre[y]),hi=std::max(hi,pre[y]);
+				}
+				low[x]=lo,high[x]=hi;
+			});
 		}
+		//x 是否是 y 的祖先（包括 x=y）。
+		inline bool ancestor(int x,int y) const{
+			return pre[x]<=pre[y]&&pre[y]<pre[x]+siz[x];
+		}
+	};
+
+
+	class CHECKTREE{
 	public:
-		//返回以 1 为根的树中每个点的深度，1 的深度为 1。
-		inline std::vector<int> Get_dep(std::vector<std::pair<int,int>> tree){
-			std::vector<int> dep(int(tree.size())+1,0);
+		//返回以 1 为根的树中每个点的深度，1 的深度为 1，第 i 个数为 i+1 号点的深度。threads 为逐层 bfs 使用的线程数。
+		inline std::vector<int> Get_dep(const std::vector<std::pair<int,int>> &tree,int threads=1){
+			int n=int(tree.size())+1;
+			FESDRER_STL::FGraph g(n,tree,0);
+			std::vector<int> dep(n,0),now(1,1),next(0);
 			dep[0]=1;
-			std::vector<std::vector<int>> e(int(tree.size())+2,std::vector<int>{});
-			for(std::pair<int,int> i:tree){
-				e[i.first].push_back(i.second);
-				e[i.second].push_back(i.first);
+			//树上每个点只和一个上一层的点相邻，所以不会有两个线程同时写同一个点。
+			while(now.size()){
+				CheckTool.expand(g,now,next,threads,[&](int x,int y,int){
+					if(dep[y-1])	return false;
+					dep[y-1]=dep[x-1]+1;
+					return true;
+				});
+				now.swap(next);
 			}
-			dep_dfs(1,0,e,dep);
 			return dep;
 		}
-		//返回树中每个点的度数。
-		inline std::vector<int> Get_degree(std::vector<std::pair<int,int>> tree){
-			std::vector<int> degree(int(tree.size())+1,0);
-			for(std::pair<int,int> i:tree)	degree[i.first]++,degree[i.second]++;
+		//返回树中每个点的度数，下标为点的编号，第 0 个数不使用。
+		inline std::vector<int> Get_degree(const std::vector<std::pair<int,int>> &tree,int threads=1){
+			int n=int(tree.size())+1;
+			std::vector<int> degree(n+1,0);
+			if(threads<=1){
+				for(const std::pair<int,int> &i:tree)	degree[i.first]++,degree[i.second]++;
+				return degree;
+			}
+			std::vector<std::atomic<int>> cnt(n+1);
+			CheckTool.each(n+1,threads,[&](int x){cnt[x].store(0,std::memory_order_relaxed);});
+			CheckTool.each(n-1,threads,[&](int i){
+				cnt[tree[i].first].fetch_add(1,std::memory_order_relaxed);
+				cnt[tree[i].second].fetch_add(1,std::memory_order_relaxed);
+			});
+			CheckTool.each(n+1,threads,[&](int x){degree[x]=cnt[x].load(std::memory_order_relaxed);});
 			return degree;
 		}
 	};
@@ -1048,38 +3380,127 @@ namespace FESDRER_CHECK{
 
 	class CHECKSCC{
 	private:
-		inline void tarjan(int x,std::vector<int> &dfn,std::vector<int> &low,std::stack<int> &stk,std::vector<int> &fst,std::vector<int> &nxt,std::vector<int> &tal,std::vector<bool> &instk,std::vector<std::vector<int>> &scc,int &tod){
-			dfn[x]=low[x]=++tod;
-			stk.push(x),instk[x]=1;
-			for(int i=fst[x];i;i=nxt[i]){
-				int y=tal[i];
-				if(!dfn[y])	tarjan(y,dfn,low,stk,fst,nxt,tal,instk,scc,tod),low[x]=std::min(low[x],low[y]);
-				else	if(instk[y])	low[x]=std::min(low[x],dfn[y]);
-			}
-			if(low[x]==dfn[x]){
-				int y;
-				std::vector<int> now(0);
-				do{
-					y=stk.top();stk.pop();
-					now.push_back(y),instk[y]=0;
+		enum{SMALL=1<<14};
+		/*
+		在 ok(y) 为真的点构成的子图上，依次从 nodes 中还没访问过的点出发做非递归的 Tarjan，求出的强连通分量加入 scc。
+		dfn、low、cur、bel 以点的编号为下标，stk、call 至少要能放下 nodes.size() 个数。
+		*/
+		template<typename OK> inline void tarjan(const FESDRER_STL::FGraph &g,const std::vector<int> &nodes,OK ok,int *dfn,int *low,int *cur,int *bel,int *stk,int *call,std::vector<std::vector<int>> &scc){
+			int tod=0,top=0,depth=0;
+			for(int s:nodes)	if(!dfn[s]){
+				dfn[s]=low[s]=++tod,cur[s]=g.fst[s],stk[top++]=s,call[depth++]=s;
+				while(depth){
+					int x=call[depth-1];
+					if(cur[x]<g.fst[x+1]){
+						int y=g.to[cur[x]++];
+						if(!ok(y))	continue;
+						if(!dfn[y])	dfn[y]=low[y]=++tod,cur[y]=g.fst[y],stk[top++]=y,call[depth++]=y;
+						else	if(!bel[y])	low[x]=std::min(low[x],dfn[y]);
+						continue;
+					}
+					if(low[x]==dfn[x]){
+						int y;
+						std::vector<int> now(0);
+						do{
+							y=stk[--top];
+							now.push_back(y),bel[y]=1;
+						}
+						while(y!=x);
+						scc.push_back(now);
+					}
+					if(--depth)	low[call[depth-1]]=std::min(low[call[depth-1]],low[x]);
 				}
-				while(y!=x);
-				scc.push_back(now);
 			}
 		}
 	public:
-		//返回有向图中的所有强连通分量。
-		inline std::vector<std::vector<int>> check(int n,std::vector<std::pair<int,int>> graph){
-			int N=n+5,m=int(graph.size()),M=m+5;
-			std::vector<int> fst(N),nxt(M),tal(M),dfn(N),low(N);
-			std::vector<bool> instk(N);
-			int tot=1,tod=0;
-			std::stack<int> stk;
+		/*
+		返回有向图中的所有强连通分量。
+		threads 大于 1 时先并行地删去入度或出度为 0 的点（trim），再用 forward-backward 算法从一个点出发并行地 bfs 正图和反图，
+		两边都能到的点是一个强连通分量，只有一边能到的点和两边都到不了的点分成三块分别处理，不超过 SMALL 个点的块并行地用 Tarjan 求解。
+		*/
+		inline std::vector<std::vector<int>> check(int n,const std::vector<std::pair<int,int>> &graph,int threads=1){
+			FESDRER_STL::FGraph g(n,graph,1);
+			std::vector<int> arena(4*(n+1),0);
+			int *dfn=arena.data(),*low=dfn+n+1,*cur=low+n+1,*bel=cur+n+1;
 			std::vector<std::vector<int>> scc(0);
-			while(stk.size())	stk.pop();
-			auto add=[&](int x,int y){tal[++tot]=y,nxt[tot]=fst[x],fst[x]=tot;};
-			for(std::pair<int,int> it:graph)	add(it.first,it.second);
-			for(int i=1;i<=n;i++)	if(!dfn[i])	tarjan(i,dfn,low,stk,fst,nxt,tal,instk,scc,tod);
+			if(threads<=1){
+				std::vector<int> nodes(n),stk(n),call(n);
+				for(int i=0;i<n;i++)	nodes[i]=i+1;
+				tarjan(g,nodes,[](int){return true;},dfn,low,cur,bel,stk.data(),call.data(),scc);
+				return scc;
+			}
+			FESDRER_STL::FGraph rg=g.transpose();
+			std::vector<int> color(n+1,0),now(0),next(0);
+			std::vector<std::atomic<int>> in(n+1),out(n+1);
+			std::vector<std::atomic<unsigned char>> mark(n+1);
+			CheckTool.each(n+1,threads,[&](int x){
+				in[x].store(rg.fst[x+1]-rg.fst[x],std::memory_order_relaxed);
+				out[x].store(g.fst[x+1]-g.fst[x],std::memory_order_relaxed);
+				mark[x].store(0,std::memory_order_relaxed);
+			});
+			//trim：入度或出度为 0 的点自己是一个强连通分量，删掉后继续检查它的邻居。
+			CheckTool.gather(n,threads,now,[&](int k,std::vector<int> &ret){
+				int x=k+1;
+				if(!in[x].load(std::memory_order_relaxed)||!out[x].load(std::memory_order_relaxed))	mark[x].store(4,std::memory_order_relaxed),ret.push_back(x);
+			});
+			while(now.size()){
+				for(int x:now)	scc.push_back(std::vector<int>{x});
+				CheckTool.each(int(now.size()),threads,[&](int k){color[now[k]]=-1;});
+				CheckTool.gather(int(now.size()),threads,next,[&](int k,std::vector<int> &ret){
+					int x=now[k];
+					for(int i=g.fst[x];i<g.fst[x+1];i++){
+						int y=g.to[i];
+						if(in[y].fetch_sub(1,std::memory_order_relaxed)==1&&CheckTool.claim(mark[y],4))	ret.push_back(y);
+					}
+					for(int i=rg.fst[x];i<rg.fst[x+1];i++){
+						int y=rg.to[i];
+						if(out[y].fetch_sub(1,std::memory_order_relaxed)==1&&CheckTool.claim(mark[y],4))	ret.push_back(y);
+					}
+				});
+				now.swap(next),next.clear();
+			}
+			std::vector<std::vector<int>> work(1),small(0);
+			CheckTool.gather(n,threads,work[0],[&](int k,std::vector<int> &ret){if(color[k+1]!=-1)	ret.push_back(k+1);});
+			int colors=1;
+			//forward-backward：标记 1 表示从 pivot 出发能到，标记 2 表示能到 pivot。
+			auto reach=[&](const FESDRER_STL::FGraph &G,int pivot,int c,unsigned char bit){
+				CheckTool.claim(mark[pivot],bit);
+				now.assign(1,pivot);
+				while(now.size()){
+					CheckTool.expand(G,now,next,threads,[&](int,int y,int){return color[y]==c&&CheckTool.claim(mark[y],bit);});
+					now.swap(next);
+				}
+			};
+			while(work.size()){
+				std::vector<int> part;
+				part.swap(work.back()),work.pop_back();
+				if(part.empty())	continue;
+				if(int(part.size())<=SMALL){
+					small.push_back(std::vector<int>(0)),small.back().swap(part);
+					continue;
+				}
+				int c=color[part[0]];
+				reach(g,part[0],c,1),reach(rg,part[0],c,2);
+				std::vector<int> both(0);
+				CheckTool.gather(int(part.size()),threads,both,[&](int k,std::vector<int> &ret){if(mark[part[k]].load(std::memory_order_relaxed)==3)	ret.push_back(part[k]);});
+				for(unsigned char m=0;m<3;m++){
+					work.push_back(std::vector<int>(0));
+					CheckTool.gather(int(part.size()),threads,work.back(),[&](int k,std::vector<int> &ret){if(mark[part[k]].load(std::memory_order_relaxed)==m)	ret.push_back(part[k]);});
+					std::vector<int> &add=work.back();
+					CheckTool.each(int(add.size()),threads,[&](int k){color[add[k]]=colors;});
+					colors++;
+				}
+				CheckTool.each(int(both.size()),threads,[&](int k){color[both[k]]=-1;});
+				CheckTool.each(int(part.size()),threads,[&](int k){mark[part[k]].store(0,std::memory_order_relaxed);});
+				scc.push_back(both);
+			}
+			std::vector<std::vector<std::vector<int>>> res(small.size());
+			FESDRER_STL::parallel_for(int(small.size()),threads,[&](int k){
+				int c=color[small[k][0]];
+				std::vector<int> stk(small[k].size()),call(small[k].size());
+				tarjan(g,small[k],[&](int y){return color[y]==c;},dfn,low,cur,bel,stk.data(),call.data(),res[k]);
+			});
+			for(std::vector<std::vector<int>> &it:res)	for(std::vector<int> &i:it)	scc.push_back(std::vector<int>(0)),scc.back().swap(i);
 			return scc;
 		}
 	};
@@ -1087,83 +3508,148 @@ namespace FESDRER_CHECK{
 
 
 	class CHECKEDCC{
-	private:
-		inline void tarjan(int x,int in_edge,std::vector<int> &fst,std::vector<int> &nxt,std::vector<int> &tal,std::vector<int> &dfn,std::vector<int> &low,std::stack<int> &stk,std::vector<std::vector<int>> &edcc,int &tod){
-			dfn[x]=low[x]=++tod;
-			stk.push(x);
-			for(int i=fst[x];i;i=nxt[i]){
-				int y=tal[i];
-				if(!dfn[y])	tarjan(y,i,fst,nxt,tal,dfn,low,stk,edcc,tod),low[x]=std::min(low[x],low[y]);
-				else	if(i!=(1^in_edge))	low[x]=std::min(low[x],dfn[y]);
-			}
-			if(dfn[x]==low[x]){
-				int y;
-				std::vector<int> now(0);
-				do{
-					y=stk.top();stk.pop();
-					now.push_back(y);
-				}
-				while(y!=x);
-				edcc.push_back(now);
-			}
-		}
 	public:
-		//返回有向图中的所有边双连通分量。
-		inline void check(int n,std::vector<std::pair<int,int>> graph){
-			int N=n+5,m=int(graph.size()),M=m*2+5;
-			std::vector<int> fst(N),nxt(M),tal(M),dfn(N),low(N);
-			int tot=1,tod=0;
-			std::stack<int> stk;
+		/*
+		返回无向图中的所有边双连通分量。
+		threads 大于 1 时先并行地求出 bfs 生成森林，树边 (fa[x],x) 是桥当且仅当 x 子树中的点经过非树边到不了子树外，
+		删掉桥后生成森林的每个连通块就是一个边双连通分量。
+		*/
+		inline std::vector<std::vector<int>> check(int n,const std::vector<std::pair<int,int>> &graph,int threads=1){
+			FESDRER_STL::FGraph g(n,graph,0);
 			std::vector<std::vector<int>> edcc(0);
-			while(stk.size())	stk.pop();
-			auto add=[&](int x,int y){tal[++tot]=y,nxt[tot]=fst[x],fst[x]=tot;};
-			for(std::pair<int,int> it:graph)	add(it.first,it.second),add(it.second,it.first);
-			for(int i=1;i<=n;i++)	if(!dfn[i])	tarjan(i,0,fst,nxt,tal,dfn,low,stk,edcc,tod);
+			if(threads>1){
+				FOREST f(g,threads);
+				std::vector<int> id(n+1,-1);
+				int cnt=0;
+				auto head=[&](int x){return !f.fa[x]||(f.low[x]>=f.pre[x]&&f.high[x]<f.pre[x]+f.siz[x]);};
+				for(int x:f.order)	if(head(x))	id[x]=cnt++;
+				for(int d=0;d+1<int(f.level.size());d++)	CheckTool.each(f.level[d+1]-f.level[d],threads,[&](int k){
+					int x=f.order[f.level[d]+k];
+					if(!head(x))	id[x]=id[f.fa[x]];
+				});
+				std::vector<int> num(cnt,0);
+				for(int x=1;x<=n;x++)	num[id[x]]++;
+				edcc.resize(cnt);
+				for(int i=0;i<cnt;i++)	edcc[i].reserve(num[i]);
+				for(int x=1;x<=n;x++)	edcc[id[x]].push_back(x);
+				return edcc;
+			}
+			std::vector<int> arena(6*(n+1),0);
+			int *dfn=arena.data(),*low=dfn+n+1,*pre=low+n+1,*cur=pre+n+1,*stk=cur+n+1,*call=stk+n+1;
+			int tod=0,top=0,depth=0;
+			for(int s=1;s<=n;s++)	if(!dfn[s]){
+				dfn[s]=low[s]=++tod,cur[s]=g.fst[s],pre[s]=-1,stk[top++]=s,call[depth++]=s;
+				while(depth){
+					int x=call[depth-1];
+					if(cur[x]<g.fst[x+1]){
+						int i=cur[x]++,y=g.to[i];
+						if(g.eid[i]==pre[x])	continue;
+						if(!dfn[y])	dfn[y]=low[y]=++tod,cur[y]=g.fst[y],pre[y]=g.eid[i],stk[top++]=y,call[depth++]=y;
+						else	low[x]=std::min(low[x],dfn[y]);
+						continue;
+					}
+					if(low[x]==dfn[x]){
+						int y;
+						std::vector<int> now(0);
+						do{
+							y=stk[--top];
+							now.push_back(y);
+						}
+						while(y!=x);
+						edcc.push_back(now);
+					}
+					if(--depth)	low[call[depth-1]]=std::min(low[call[depth-1]],low[x]);
+				}
+			}
+			return edcc;
 		}
 	};
 	static CHECKEDCC CheckEdcc;
 
 
 	class CHECKVDCC{
-	private:
-		void tarjan(int x,std::vector<int> &fst,std::vector<int> &nxt,std::vector<int> &tal,std::vector<int> &dfn,std::vector<int> &low,std::stack<int> &stk,std::vector<std::vector<int>> &vdcc,int &tod,int &root){
-			if(x==root&&!fst[x]){
-				vdcc.push_back(std::vector<int>{x});
-				return;
+	public:
+		/*
+		返回无向图中的所有点双连通分量，孤立点单独成为一个点双连通分量。
+		threads 大于 1 时用 Tarjan-Vishkin 算法：每条树边 (fa[x],x) 看成点 x，按规则把应该在同一个点双里的树边连起来，
+		这个辅助图的每个连通块加上块中最高的树边的上端点就是一个点双连通分量。
+		*/
+		inline std::vector<std::vector<int>> check(int n,const std::vector<std::pair<int,int>> &graph,int threads=1){
+			FESDRER_STL::FGraph g(n,graph,0);
+			std::vector<std::vector<int>> vdcc(0);
+			if(threads>1){
+				FOREST f(g,threads);
+				//规则一：非树边 (x,y) 的两端没有祖先关系时，两端的树边在同一个点双里。
+				//规则二：x 的子树经过非树边能到 fa[x] 的子树外时，(fa[x],x) 和 (fa[fa[x]],fa[x]) 在同一个点双里。
+				std::vector<int> link(0);
+				CheckTool.gather(n,threads,link,[&](int k,std::vector<int> &ret){
+					int x=k+1,p=f.fa[x];
+					for(int i=g.fst[x];i<g.fst[x+1];i++){
+						int y=g.to[i];
+						if(f.pre[x]<f.pre[y]&&!f.ancestor(x,y))	ret.push_back(x),ret.push_back(y);
+					}
+					if(p&&f.fa[p]&&(f.low[x]<f.pre[p]||f.high[x]>=f.pre[p]+f.siz[p]))	ret.push_back(x),ret.push_back(p);
+				});
+				std::vector<std::pair<int,int>> aux(link.size()/2);
+				CheckTool.each(int(aux.size()),threads,[&](int k){aux[k]={link[2*k],link[2*k+1]};});
+				std::vector<int>().swap(link);
+				FESDRER_STL::FGraph h(n,aux,0);
+				std::vector<std::pair<int,int>>().swap(aux);
+				std::vector<std::atomic<unsigned char>> vis(n+1);
+				CheckTool.each(n+1,threads,[&](int x){vis[x].store(0,std::memory_order_relaxed);});
+				std::vector<int> now(0),next(0);
+				for(int x:f.order){
+					if(!f.fa[x]){
+						if(!f.son[x])	vdcc.push_back(std::vector<int>{x});
+						continue;
+					}
+					if(!CheckTool.claim(vis[x],1))	continue;
+					std::vector<int> comp(1,x);
+					now.assign(1,x);
+					int t=x;
+					while(now.size()){
+						CheckTool.expand(h,now,next,threads,[&](int,int y,int){return CheckTool.claim(vis[y],1);});
+						comp.insert(comp.end(),next.begin(),next.end());
+						now.swap(next);
+					}
+					for(int y:comp)	if(f.pre[y]<f.pre[t])	t=y;
+					comp.push_back(f.fa[t]);
+					vdcc.push_back(comp);
+				}
+				return vdcc;
 			}
-			dfn[x]=low[x]=++tod;
-			stk.push(x);
-			for(int i=fst[x];i;i=nxt[i]){
-				int y=tal[i];
-				if(!dfn[y]){
-					tarjan(y,fst,nxt,tal,dfn,low,stk,vdcc,tod,root);
-					low[x]=std::min(low[x],low[y]);
-					if(low[y]>=dfn[x]){
+			std::vector<int> arena(5*(n+1),0);
+			int *dfn=arena.data(),*low=dfn+n+1,*cur=low+n+1,*stk=cur+n+1,*call=stk+n+1;
+			int tod=0,top=0,depth=0;
+			for(int s=1;s<=n;s++)	if(!dfn[s]){
+				dfn[s]=low[s]=++tod,cur[s]=g.fst[s],stk[top++]=s,call[depth++]=s;
+				bool child=0;
+				while(depth){
+					int x=call[depth-1];
+					if(cur[x]<g.fst[x+1]){
+						int y=g.to[cur[x]++];
+						if(!dfn[y])	dfn[y]=low[y]=++tod,cur[y]=g.fst[y],stk[top++]=y,call[depth++]=y,child|=(x==s);
+						else	low[x]=std::min(low[x],dfn[y]);
+						continue;
+					}
+					if(!--depth)	break;
+					int fa=call[depth-1];
+					low[fa]=std::min(low[fa],low[x]);
+					if(low[x]>=dfn[fa]){
 						int z;
-						std::vector<int> now(1,x);
+						std::vector<int> now(1,fa);
 						do{
-							z=stk.top();stk.pop();
+							z=stk[--top];
 							now.push_back(z);
 						}
-						while(z!=y);
+						while(z!=x);
 						vdcc.push_back(now);
 					}
 				}
-				else	low[x]=std::min(low[x],dfn[y]);
+				if(!child)	vdcc.push_back(std::vector<int>{s});
+				top=0;
 			}
-		}
-	public:
-		//返回有向图中的所有边双连通分量。
-		inline void check(int n,std::vector<std::pair<int,int>> graph){
-			int N=n+5,m=int(graph.size()),M=m*2+5;
-			std::vector<int> fst(N),nxt(M),tal(M),dfn(N),low(N);
-			int tot=1,tod=0,root=0;
-			std::stack<int> stk;
-			std::vector<std::vector<int>> vdcc(0);
-			while(stk.size())	stk.pop();
-			auto add=[&](int x,int y){tal[++tot]=y,nxt[tot]=fst[x],fst[x]=tot;};
-			for(std::pair<int,int> it:graph)	add(it.first,it.second),add(it.second,it.first);
-			for(int i=1;i<=n;i++)	if(!dfn[i])	tarjan((root=i),fst,nxt,tal,dfn,low,stk,vdcc,tod,root);
+			return vdcc;
 		}
 	};
 	static CHECKVDCC CheckVdcc;
@@ -1173,12 +3659,15 @@ namespace FESDRER_CHECK{
 using FESDRER_RAND::random;
 using FESDRER_RAND::randomreal;
 using FESDRER_RAND::RandomBasic;
+using FESDRER_RAND::RandomDistinct;
 using FESDRER_RAND::RandomPrint;
 using FESDRER_RAND::RandomAnother;
 using FESDRER_RAND::RandomGraphTool;
 using FESDRER_RAND::RandomTree;
 using FESDRER_RAND::RandomGraph;
 using FESDRER_RAND::RandomHackSpfa;
+using FESDRER_RAND::RandomHack;
+using FESDRER_RAND::RandomFlow;
 using FESDRER_RAND::RandomDag;
 using FESDRER_RAND::RandomScc;
 using FESDRER_RAND::RandomEdcc;
@@ -1190,4 +3679,39 @@ using FESDRER_CHECK::CheckEdcc;
 using FESDRER_CHECK::CheckVdcc;
 
 
+/*
+定义 FESDRER_STATS 时替换全局的 operator new，把申请内存的次数和字节数计入 RandomStats。
+多个源文件都包含本文件时，除一个以外都要再定义 FESDRER_STATS_NO_NEW，否则 operator new 会重复定义。
+*/
+#if defined(FESDRER_STATS)&&!defined(FESDRER_STATS_NO_NEW)
+#include <new>
+#include <cstdlib>
+#if defined(__GNUC__)&&!defined(__clang__)&&__GNUC__>=11
+#pragma GCC diagnostic ignored "-Wmismatched-new-delete"
+#endif
+void* operator new(size_t n){
+	FESDRER_STAT_ADD(allocs,1);
+	FESDRER_STAT_ADD(bytes,n);
+	void *p=malloc(n?n:1);
+	if(!p)	throw std::bad_alloc();
+	return p;
+}
+void* operator new[](size_t n){
+	return operator new(n);
+}
+void operator delete(void *p) noexcept{
+	free(p);
+}
+void operator delete[](void *p) noexcept{
+	free(p);
+}
+void operator delete(void *p,size_t) noexcept{
+	free(p);
+}
+void operator delete[](void *p,size_t) noexcept{
+	free(p);
+}
+#endif
+
+
 #endif